@@ -0,0 +1,555 @@
+#include "asyncStream.h"
+
+#if defined(__cpp_impl_coroutine)
+
+#include <cstring>
+
+#include "bufferPool.h"
+
+
+namespace {
+
+/**
+* \brief  ,     .
+*
+*   ( 1    )       finish,
+*       K1  K2.
+*/
+struct imitoChain {
+    uint8_t state[16] = { 0 };
+    uint8_t pending[16] = { 0 };
+    size_t pendingLength = 0;
+
+    void update(const blockCipher& cipher, const uint8_t* data, size_t length) {
+        const size_t n = cipher.getBlockSize();
+        if (pendingLength + length <= n) {
+            memcpy(pending + pendingLength, data, length);
+            pendingLength += length;
+            return;
+        }
+
+        size_t fill = n - pendingLength;
+        memcpy(pending + pendingLength, data, fill);
+        cipher.imitoAbsorb(state, pending, 1);
+        data += fill;
+        length -= fill;
+
+        size_t blocks = (length - 1) / n;
+        cipher.imitoAbsorb(state, data, blocks);
+        data += blocks * n;
+        length -= blocks * n;
+
+        memcpy(pending, data, length);
+        pendingLength = length;
+    }
+
+    void finish(const blockCipher& cipher, uint8_t* imito, size_t imitoLength) const {
+        cipher.imitoFinish(state, pending, pendingLength, imito, imitoLength);
+    }
+};
+
+/**
+* \brief    :  ,    .
+*/
+struct pendingChunk {
+    pendingChunk(size_t size, bool withOutput) : input(size) {
+        if (withOutput) {
+            output = poolBuffer(size);
+        }
+    }
+
+    poolBuffer input;
+    poolBuffer output;
+    size_t length = 0;
+    std::unique_ptr<offloadedWork> work;
+};
+
+
+/**
+* \brief         .
+*
+* \param [in] in  .
+* \param [out] data  .
+* \param [in] length   .
+* \return     ( length    ).
+*/
+asyncTask<size_t> readFull(asyncReader& in, uint8_t* data, size_t length) {
+    size_t total = 0;
+    while (total < length) {
+        size_t received = co_await in.read(data + total, length - total);
+        if (received == 0) {
+            break;
+        }
+        total += received;
+    }
+    co_return total;
+}
+
+}
+
+
+/**
+* \brief        (  ).
+*
+* \param [in] handle    .
+*/
+void eventLoop::post(std::coroutine_handle<> handle) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ready.push_back(handle);
+    }
+    readyCondition.notify_one();
+}
+
+
+void eventLoop::runOne() {
+    std::coroutine_handle<> handle;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        readyCondition.wait(lock, [this] { return !ready.empty(); });
+        handle = ready.front();
+        ready.pop_front();
+    }
+    handle.resume();
+}
+
+
+eventLoop::detachedTask eventLoop::start(asyncTask<void> task, std::exception_ptr* error, bool* finished) {
+    try {
+        co_await task;
+    }
+    catch (...) {
+        if (!error) {
+            throw;
+        }
+        *error = std::current_exception();
+    }
+
+    if (finished) {
+        *finished = true;
+    }
+}
+
+
+/**
+* \brief      .
+*
+*        ,     .
+*       (std::terminate).
+*
+* \param [in] task  .
+*/
+void eventLoop::spawn(asyncTask<void> task) {
+    start(std::move(task), nullptr, nullptr);
+}
+
+
+/**
+* \brief       .
+*
+*      .    .
+*
+* \param [in] task  .
+*/
+void eventLoop::runUntilComplete(asyncTask<void> task) {
+    std::exception_ptr error;
+    bool finished = false;
+
+    start(std::move(task), &error, &finished);
+    while (!finished) {
+        runOne();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+
+/**
+* \brief    .
+*
+* \param [in] threadCount    (0     ).
+*/
+cipherWorkers::cipherWorkers(unsigned threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+
+    for (unsigned i = 0; i < threadCount; i++) {
+        threads.emplace_back(&cipherWorkers::workerLoop, this);
+    }
+}
+
+
+/**
+* \brief   :      .
+*/
+cipherWorkers::~cipherWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workCondition.notify_all();
+
+    for (std::thread& t : threads) {
+        t.join();
+    }
+}
+
+
+/**
+* \brief     .
+*
+* \param [in] work  .
+*/
+void cipherWorkers::post(std::function<void()> work) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(work));
+    }
+    workCondition.notify_one();
+}
+
+
+void cipherWorkers::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true) {
+        workCondition.wait(lock, [this] { return stopping || !queue.empty(); });
+        if (queue.empty()) {
+            break;
+        }
+
+        std::function<void()> work = std::move(queue.front());
+        queue.pop_front();
+        lock.unlock();
+        work();
+        lock.lock();
+    }
+}
+
+
+/**
+* \brief :    .
+*
+* \param [in] loop   ,      .
+* \param [in] workers   .
+* \param [in] work  .
+*/
+offloadedWork::offloadedWork(eventLoop& loop, cipherWorkers& workers, std::function<void()> work)
+    : loop(&loop), state(std::make_shared<sharedState>()) {
+    std::shared_ptr<sharedState> s = state;
+    eventLoop* l = this->loop;
+
+    workers.post([s, l, work] {
+        std::exception_ptr error;
+        try {
+            work();
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+
+        std::coroutine_handle<> awaiting;
+        {
+            std::lock_guard<std::mutex> lock(s->mutex);
+            s->done = true;
+            s->error = error;
+            awaiting = s->awaiting;
+        }
+        if (awaiting) {
+            l->post(awaiting);
+        }
+    });
+}
+
+
+bool offloadedWork::await_ready() const noexcept {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->done;
+}
+
+
+bool offloadedWork::await_suspend(std::coroutine_handle<> awaiting) {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (state->done) {
+        return false;
+    }
+    state->awaiting = awaiting;
+    return true;
+}
+
+
+void offloadedWork::await_resume() {
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+
+/**
+* \brief    .
+*
+* \param [in] loop      .
+* \param [in] capacity     .
+*/
+memoryPipe::memoryPipe(eventLoop& loop, size_t capacity) : loop(loop), ring(capacity == 0 ? 1 : capacity, 0) {
+}
+
+
+void memoryPipe::wake(std::coroutine_handle<>& slot) {
+    if (slot) {
+        std::coroutine_handle<> handle = slot;
+        slot = nullptr;
+        loop.post(handle);
+    }
+}
+
+
+/**
+* \brief     ( ,   ).
+*
+* \param [out] data  .
+* \param [in] length   .
+* \return      0,     .
+*/
+asyncTask<size_t> memoryPipe::read(uint8_t* data, size_t length) {
+    while (fill == 0 && !closed) {
+        co_await waitAwaiter{ &waitingReader };
+    }
+
+    size_t count = fill < length ? fill : length;
+    for (size_t done = 0; done < count;) {
+        size_t part = ring.size() - head < count - done ? ring.size() - head : count - done;
+        memcpy(data + done, ring.data() + head, part);
+        head = (head + part) % ring.size();
+        done += part;
+    }
+    fill -= count;
+
+    if (count > 0) {
+        wake(waitingWriter);
+    }
+    co_return count;
+}
+
+
+/**
+* \brief     (  ,   ).
+*
+* ,    , .
+*
+* \param [in] data  .
+* \param [in] length     .
+*/
+asyncTask<void> memoryPipe::write(const uint8_t* data, size_t length) {
+    while (length > 0 && !closed) {
+        while (fill == ring.size()) {
+            co_await waitAwaiter{ &waitingWriter };
+        }
+
+        size_t tail = (head + fill) % ring.size();
+        size_t part = ring.size() - fill < length ? ring.size() - fill : length;
+        if (part > ring.size() - tail) {
+            part = ring.size() - tail;
+        }
+        memcpy(ring.data() + tail, data, part);
+        fill += part;
+        if (fill > peakFill) {
+            peakFill = fill;
+        }
+        data += part;
+        length -= part;
+
+        wake(waitingReader);
+    }
+}
+
+
+/**
+* \brief   :       .
+*/
+void memoryPipe::close() {
+    closed = true;
+    wake(waitingReader);
+}
+
+
+/**
+* \brief   .
+*
+* \param [in] loop   ,    .
+* \param [in] workers       .
+* \param [in] cipher     (    ).
+* \param [in] options   ,         .
+*/
+asyncStreamCipher::asyncStreamCipher(eventLoop& loop, cipherWorkers& workers, const blockCipher& cipher,
+                                     asyncStreamOptions options)
+    : loop(loop), workers(workers), cipher(cipher), options(options) {
+    this->options.chunkSize = (options.chunkSize + 15) / 16 * 16;
+    if (this->options.chunkSize == 0) {
+        this->options.chunkSize = 16;
+    }
+    if (this->options.maxInFlight == 0) {
+        this->options.maxInFlight = 1;
+    }
+}
+
+
+/**
+* \brief   :        .
+*
+*  ,     maxInFlight .   ,
+*        (    )
+*     .      .
+*
+* \param [in] in  .
+* \param [in] out    nullptr ( ).
+* \param [in] sync       ( out = nullptr  ).
+* \param [in] macInput      ,    .
+* \param [out] imito    nullptr.
+* \param [in] imitoLength     .
+* \return    .
+*/
+asyncTask<uint64_t> asyncStreamCipher::process(asyncReader& in, asyncWriter* out, const uint8_t* sync,
+                                               bool macInput, uint8_t* imito, size_t imitoLength) {
+    const size_t blockSize = cipher.getBlockSize();
+    imitoChain chain;
+    std::deque<std::unique_ptr<pendingChunk>> window;
+    uint64_t total = 0;
+    bool finished = false;
+    std::exception_ptr error;
+
+    try {
+        while (true) {
+            while (!finished && window.size() < options.maxInFlight) {
+                std::unique_ptr<pendingChunk> chunk(new pendingChunk(options.chunkSize, out != nullptr));
+                chunk->length = co_await readFull(in, chunk->input.data(), options.chunkSize);
+                finished = chunk->length < options.chunkSize;
+                if (chunk->length == 0) {
+                    break;
+                }
+
+                if (out) {
+                    pendingChunk* c = chunk.get();
+                    const blockCipher* k = &cipher;
+                    uint64_t counter = options.firstCounter + total / blockSize;
+                    chunk->work.reset(new offloadedWork(loop, workers, [c, k, sync, counter] {
+                        k->ctrCrypt(sync, counter, c->input.data(), c->output.data(), c->length);
+                    }));
+                }
+                total += chunk->length;
+                window.push_back(std::move(chunk));
+            }
+            if (window.empty()) {
+                break;
+            }
+
+            pendingChunk& chunk = *window.front();
+            if (chunk.work) {
+                co_await *chunk.work;
+            }
+            if (imito) {
+                const uint8_t* data = out && !macInput ? chunk.output.data() : chunk.input.data();
+                size_t length = chunk.length;
+                imitoChain* c = &chain;
+                const blockCipher* k = &cipher;
+                co_await offloadedWork(loop, workers, [c, k, data, length] { c->update(*k, data, length); });
+            }
+            if (out) {
+                co_await out->write(chunk.output.data(), chunk.length);
+            }
+            window.pop_front();
+        }
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+
+    if (error) {
+        while (!window.empty()) {
+            if (window.front()->work) {
+                try {
+                    co_await *window.front()->work;
+                }
+                catch (...) {
+                }
+            }
+            window.pop_front();
+        }
+        std::rethrow_exception(error);
+    }
+
+    if (imito) {
+        chain.finish(cipher, imito, imitoLength);
+    }
+    co_return total;
+}
+
+
+/**
+* \brief       .
+*
+* \param [in] in    .
+* \param [in] out    (   ).
+* \param [in] sync       (   ).
+* \param [out] imito      nullptr.
+* \param [in] imitoLength      (   ).
+* \return    .
+*/
+asyncTask<uint64_t> asyncStreamCipher::encrypt(asyncReader& in, asyncWriter& out, const uint8_t* sync,
+                                               uint8_t* imito, size_t imitoLength) {
+    return process(in, &out, sync, false, imito, imitoLength);
+}
+
+
+/**
+* \brief          .
+*
+*        ,   :
+*   false     .
+*
+* \param [in] in   .
+* \param [in] out     (   ).
+* \param [in] sync       (   ).
+* \param [in] imito       nullptr ( ).
+* \param [in] imitoLength      ( 1   ).
+* \return  true,      ; false  
+*     .
+*/
+asyncTask<bool> asyncStreamCipher::decrypt(asyncReader& in, asyncWriter& out, const uint8_t* sync,
+                                           const uint8_t* imito, size_t imitoLength) {
+    uint8_t computed[16];
+    co_await process(in, &out, sync, true, imito ? computed : nullptr, imitoLength);
+    if (!imito) {
+        co_return true;
+    }
+    if (imitoLength == 0 || imitoLength > cipher.getBlockSize()) {
+        co_return false;
+    }
+
+    uint8_t difference = 0;
+    for (size_t i = 0; i < imitoLength; i++) {
+        difference |= computed[i] ^ imito[i];
+    }
+    co_return difference == 0;
+}
+
+
+/**
+* \brief      .
+*
+* \param [in] in   .
+* \param [out] imito  .
+* \param [in] imitoLength      (   ).
+* \return    .
+*/
+asyncTask<uint64_t> asyncStreamCipher::imito(asyncReader& in, uint8_t* imito, size_t imitoLength) {
+    return process(in, nullptr, nullptr, false, imito, imitoLength);
+}
+
+#endif
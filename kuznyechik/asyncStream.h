@@ -0,0 +1,372 @@
+#ifndef _ASYNC_STREAM_H_
+#define _ASYNC_STREAM_H_
+
+//      C++20 (g++ -std=c++20, MSVC /std:c++latest).
+//      ,      .
+#if defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "blockCipher.h"
+
+/**
+* \brief     asyncTask.
+*
+*    ( co_await)      .
+*/
+struct asyncPromiseBase {
+    struct finalAwaiter {
+        bool await_ready() noexcept {
+            return false;
+        }
+
+        template <class Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            std::coroutine_handle<> continuation = handle.promise().continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() noexcept {
+        }
+    };
+
+    std::suspend_always initial_suspend() noexcept {
+        return {};
+    }
+
+    finalAwaiter final_suspend() noexcept {
+        return {};
+    }
+
+    void unhandled_exception() {
+        error = std::current_exception();
+    }
+
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+};
+
+template <class T>
+struct asyncPromise : asyncPromiseBase {
+    void return_value(T v) {
+        value.emplace(std::move(v));
+    }
+
+    T result() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(*value);
+    }
+
+    std::optional<T> value;
+};
+
+template <>
+struct asyncPromise<void> : asyncPromiseBase {
+    void return_void() {
+    }
+
+    void result() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+/**
+* \brief      T.
+*
+*    co_await      eventLoop::runUntilComplete.
+* ,   ,  .
+*/
+template <class T = void>
+class asyncTask {
+public:
+    struct promise_type : asyncPromise<T> {
+        asyncTask get_return_object() {
+            return asyncTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+    };
+
+    asyncTask(asyncTask&& other) noexcept : handle(other.handle) {
+        other.handle = nullptr;
+    }
+
+    asyncTask& operator=(asyncTask&& other) noexcept {
+        if (this != &other) {
+            if (handle) {
+                handle.destroy();
+            }
+            handle = other.handle;
+            other.handle = nullptr;
+        }
+        return *this;
+    }
+
+    asyncTask(const asyncTask&) = delete;
+    asyncTask& operator=(const asyncTask&) = delete;
+
+    ~asyncTask() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    bool await_ready() const noexcept {
+        return handle.done();
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+
+    T await_resume() {
+        return handle.promise().result();
+    }
+private:
+    explicit asyncTask(std::coroutine_handle<promise_type> handle) : handle(handle) {
+    }
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+/**
+* \brief   ,       .
+*
+*     ,  run/runUntilComplete.  
+* ( )    post,     .
+*/
+class eventLoop {
+public:
+    void post(std::coroutine_handle<> handle);
+
+    void spawn(asyncTask<void> task);
+    void runUntilComplete(asyncTask<void> task);
+
+    template <class T>
+    T runUntilComplete(asyncTask<T> task) {
+        std::optional<T> value;
+        runUntilComplete(store(std::move(task), value));
+        return std::move(*value);
+    }
+private:
+    struct detachedTask {
+        struct promise_type {
+            detachedTask get_return_object() {
+                return {};
+            }
+
+            std::suspend_never initial_suspend() noexcept {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept {
+                return {};
+            }
+
+            void return_void() {
+            }
+
+            void unhandled_exception() {
+                std::terminate();
+            }
+        };
+    };
+
+    template <class T>
+    static asyncTask<void> store(asyncTask<T> task, std::optional<T>& value) {
+        value.emplace(co_await task);
+    }
+
+    static detachedTask start(asyncTask<void> task, std::exception_ptr* error, bool* finished);
+    void runOne();
+
+    std::mutex mutex;
+    std::condition_variable readyCondition;
+    std::deque<std::coroutine_handle<>> ready;
+};
+
+/**
+* \brief     ,     .
+*/
+class cipherWorkers {
+public:
+    explicit cipherWorkers(unsigned threadCount = 0);
+    ~cipherWorkers();
+
+    cipherWorkers(const cipherWorkers&) = delete;
+    cipherWorkers& operator=(const cipherWorkers&) = delete;
+
+    void post(std::function<void()> work);
+    unsigned getThreadCount() const {
+        return static_cast<unsigned>(threads.size());
+    }
+private:
+    void workerLoop();
+
+    std::mutex mutex;
+    std::condition_variable workCondition;
+    std::deque<std::function<void()>> queue;
+    bool stopping = false;
+    std::vector<std::thread> threads;
+};
+
+/**
+* \brief ,      .
+*
+*    ; co_await    
+*      .       
+*     .
+*/
+class offloadedWork {
+public:
+    offloadedWork(eventLoop& loop, cipherWorkers& workers, std::function<void()> work);
+
+    bool await_ready() const noexcept;
+    bool await_suspend(std::coroutine_handle<> awaiting);
+    void await_resume();
+private:
+    struct sharedState {
+        std::mutex mutex;
+        bool done = false;
+        std::exception_ptr error;
+        std::coroutine_handle<> awaiting;
+    };
+
+    eventLoop* loop;
+    std::shared_ptr<sharedState> state;
+};
+
+/**
+* \brief   .
+*/
+class asyncReader {
+public:
+    virtual ~asyncReader() {
+    }
+
+    /**
+    * \brief     .
+    *
+    * \param [out] data  .
+    * \param [in] length   .
+    * \return     ( 1  length)  0   .
+    */
+    virtual asyncTask<size_t> read(uint8_t* data, size_t length) = 0;
+};
+
+/**
+* \brief   .
+*/
+class asyncWriter {
+public:
+    virtual ~asyncWriter() {
+    }
+
+    /**
+    * \brief    (,     ).
+    *
+    * \param [in] data  .
+    * \param [in] length     .
+    */
+    virtual asyncTask<void> write(const uint8_t* data, size_t length) = 0;
+};
+
+/**
+* \brief      (   pipe  ).
+*
+*  ,     ,        .
+*          .
+*/
+class memoryPipe : public asyncReader, public asyncWriter {
+public:
+    memoryPipe(eventLoop& loop, size_t capacity);
+
+    asyncTask<size_t> read(uint8_t* data, size_t length) override;
+    asyncTask<void> write(const uint8_t* data, size_t length) override;
+    void close();
+
+    size_t getPeakFill() const {
+        return peakFill;
+    }
+private:
+    struct waitAwaiter {
+        std::coroutine_handle<>* slot;
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            *slot = awaiting;
+        }
+
+        void await_resume() noexcept {
+        }
+    };
+
+    void wake(std::coroutine_handle<>& slot);
+
+    eventLoop& loop;
+    vector<uint8_t> ring;
+    size_t head = 0;
+    size_t fill = 0;
+    size_t peakFill = 0;
+    bool closed = false;
+    std::coroutine_handle<> waitingReader;
+    std::coroutine_handle<> waitingWriter;
+};
+
+/**
+* \brief   .
+*/
+struct asyncStreamOptions {
+    size_t chunkSize = 64 * 1024;   //  ,    ( 16)
+    size_t maxInFlight = 4;         //     
+    uint64_t firstCounter = 1;      //     (1  gammaCryption)
+};
+
+/**
+* \brief      .
+*
+*    asyncReader   chunkSize    , 
+*     cipherWorkers,    asyncWriter   .
+*      maxInFlight ,    
+*  (  2 * maxInFlight * chunkSize),     .
+*     (  jobScheduler)  ,   .
+*    blockCipher::ctrCrypt  blockCipher::imito    .
+*/
+class asyncStreamCipher {
+public:
+    asyncStreamCipher(eventLoop& loop, cipherWorkers& workers, const blockCipher& cipher,
+                      asyncStreamOptions options = asyncStreamOptions());
+
+    asyncTask<uint64_t> encrypt(asyncReader& in, asyncWriter& out, const uint8_t* sync,
+                                uint8_t* imito = nullptr, size_t imitoLength = 0);
+    asyncTask<bool> decrypt(asyncReader& in, asyncWriter& out, const uint8_t* sync,
+                            const uint8_t* imito = nullptr, size_t imitoLength = 0);
+    asyncTask<uint64_t> imito(asyncReader& in, uint8_t* imito, size_t imitoLength);
+private:
+    asyncTask<uint64_t> process(asyncReader& in, asyncWriter* out, const uint8_t* sync, bool macInput,
+                                uint8_t* imito, size_t imitoLength);
+
+    eventLoop& loop;
+    cipherWorkers& workers;
+    const blockCipher& cipher;
+    asyncStreamOptions options;
+};
+
+#endif
+
+#endif
@@ -0,0 +1,404 @@
+#include "autotuner.h"
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#elif defined(__i386__) || defined(__x86_64__)
+#include <cpuid.h>
+#endif
+
+
+namespace {
+
+typedef std::chrono::steady_clock tunerClock;
+
+const char* cacheHeader = "gost12_15-autotune 1";
+
+const char* operationNames[tunedOperationCount] = { "gamma", "imito" };
+const char* sizeNames[sizeClassCount] = { "small", "medium", "large" };
+const char* engineNames[] = { "table", "compact" };
+
+// ,      
+const size_t sampleSizes[sizeClassCount] = { 64, 2048, 64 * 1024 };
+//       ( )
+const size_t sampleBytes = 128 * 1024;
+const int sampleRepeats = 3;
+
+const int interleaveWidths[] = { 1, 2, 4, 8 };
+
+
+std::string getEnvironment(const char* name) {
+#ifdef _MSC_VER
+    char* value = nullptr;
+    size_t length = 0;
+    std::string result;
+    if (_dupenv_s(&value, &length, name) == 0 && value) {
+        result = value;
+        free(value);
+    }
+    return result;
+#else
+    const char* value = getenv(name);
+    return value ? value : "";
+#endif
+}
+
+
+/**
+* \brief     "table:4"  "compact" (   4).
+*/
+bool parseChoice(const std::string& text, engineChoice& choice) {
+    std::string name = text;
+    int interleave = 4;
+
+    size_t colon = text.find(':');
+    if (colon != std::string::npos) {
+        name = text.substr(0, colon);
+        interleave = atoi(text.c_str() + colon + 1);
+    }
+
+    if (name == engineNames[engineTable]) {
+        choice.engine = engineTable;
+    }
+    else if (name == engineNames[engineCompact]) {
+        choice.engine = engineCompact;
+    }
+    else {
+        return false;
+    }
+
+    if (interleave != 1 && interleave != 2 && interleave != 4 && interleave != 8) {
+        return false;
+    }
+    choice.interleave = interleave;
+    return true;
+}
+
+
+std::string formatChoice(engineChoice choice) {
+    std::ostringstream out;
+    out << engineNames[choice.engine] << ":" << choice.interleave;
+    return out.str();
+}
+
+}
+
+
+/**
+* \brief    ,     .
+*
+* \return         .
+*/
+std::string autotuner::cpuSignature() {
+    char brand[49] = { 0 };
+
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 0x80000000);
+    if (static_cast<unsigned>(regs[0]) >= 0x80000004) {
+        for (int i = 0; i < 3; i++) {
+            __cpuid(regs, 0x80000002 + i);
+            memcpy(brand + i * 16, regs, 16);
+        }
+    }
+#elif defined(__i386__) || defined(__x86_64__)
+    unsigned regs[4];
+    if (__get_cpuid_max(0x80000000, nullptr) >= 0x80000004) {
+        for (unsigned i = 0; i < 3; i++) {
+            __get_cpuid(0x80000002 + i, &regs[0], &regs[1], &regs[2], &regs[3]);
+            memcpy(brand + i * 16, regs, 16);
+        }
+    }
+#endif
+
+    std::string name(brand);
+    size_t first = name.find_first_not_of(' ');
+    name = first == std::string::npos ? "unknown" : name.substr(first);
+
+    std::ostringstream out;
+    out << name << " / " << std::thread::hardware_concurrency() << " threads";
+    return out.str();
+}
+
+
+/**
+* \brief     .
+*
+* \param [in] operation  .
+* \param [in] size   .
+* \param [in] choice   .
+* \return       (  sampleRepeats ).
+*/
+double autotuner::measure(tunedOperation operation, sizeClass size, engineChoice choice) {
+    gost12_15 &g = gost12_15::getInstance();
+    g.setEngineChoice(operation, size, choice);
+
+    uint8_t key[32];
+    for (int i = 0; i < 32; i++) {
+        key[i] = static_cast<uint8_t>(i * 0x1d + 7);
+    }
+    expandedKey expanded;
+    g.expandKey(key, expanded);
+
+    size_t messageSize = sampleSizes[size];
+    size_t messageCount = sampleBytes / messageSize;
+    vector<uint8_t> message(messageSize, 0x5a);
+    uint8_t sync[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    uint8_t imito[8];
+    double best = 0;
+
+    for (int r = 0; r < sampleRepeats; r++) {
+        tunerClock::time_point start = tunerClock::now();
+        for (size_t i = 0; i < messageCount; i++) {
+            if (operation == tunedGamma) {
+                g.gammaCryptionBlocks(expanded, sync, 1, message.data(), message.data(), messageSize);
+            }
+            else {
+                g.imitoGenerationBlocks(expanded, message.data(), messageSize, imito, sizeof(imito));
+                message[0] ^= imito[0];
+            }
+        }
+        double nanoseconds = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(tunerClock::now() - start).count());
+        double speed = static_cast<double>(messageSize * messageCount) / (nanoseconds > 0 ? nanoseconds : 1);
+        if (speed > best) {
+            best = speed;
+        }
+    }
+
+    return best;
+}
+
+
+/**
+* \brief       .
+*
+*             
+* (       ,    ),
+*     gost12_15::setEngineChoice.
+*      ,       .
+*/
+void autotuner::runBenchmarks() {
+    std::lock_guard<std::mutex> lock(mutex);
+    gost12_15 &g = gost12_15::getInstance();
+
+    for (int op = 0; op < tunedOperationCount; op++) {
+        tunedOperation operation = static_cast<tunedOperation>(op);
+
+        for (int s = 0; s < sizeClassCount; s++) {
+            sizeClass size = static_cast<sizeClass>(s);
+            engineChoice best = { engineTable, 4 };
+            double bestSpeed = 0;
+
+#ifdef GOST12_15_COMPACT_ENGINE
+            //   ,    
+            const int firstEngine = engineCompact;
+#else
+            const int firstEngine = engineTable;
+#endif
+            for (int e = firstEngine; e <= engineCompact; e++) {
+                for (int w = 0; w < 4; w++) {
+                    engineChoice choice = { static_cast<blockEngine>(e), interleaveWidths[w] };
+                    if (operation == tunedImito && choice.interleave != 1) {
+                        continue;
+                    }
+
+                    double speed = measure(operation, size, choice);
+                    if (speed > bestSpeed) {
+                        bestSpeed = speed;
+                        best = choice;
+                    }
+                }
+            }
+
+            g.setEngineChoice(operation, size, best);
+        }
+    }
+
+    tuned = true;
+}
+
+
+/**
+* \brief    .
+*
+* \param [in] cacheFile     .
+* \return  false,   ,       .
+*/
+bool autotuner::load(const std::string& cacheFile) {
+    std::ifstream in(cacheFile.c_str());
+    std::string line;
+
+    if (!std::getline(in, line) || line != cacheHeader) {
+        return false;
+    }
+    if (!std::getline(in, line) || line != "signature " + cpuSignature()) {
+        return false;
+    }
+
+    engineChoice choices[tunedOperationCount][sizeClassCount];
+    bool loaded[tunedOperationCount][sizeClassCount] = {};
+
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string operationName, sizeName, choiceText;
+        if (!(fields >> operationName >> sizeName >> choiceText)) {
+            continue;
+        }
+
+        for (int op = 0; op < tunedOperationCount; op++) {
+            for (int s = 0; s < sizeClassCount; s++) {
+                if (operationName == operationNames[op] && sizeName == sizeNames[s]) {
+                    loaded[op][s] = parseChoice(choiceText, choices[op][s]);
+                }
+            }
+        }
+    }
+
+    for (int op = 0; op < tunedOperationCount; op++) {
+        for (int s = 0; s < sizeClassCount; s++) {
+            if (!loaded[op][s]) {
+                return false;
+            }
+        }
+    }
+
+    gost12_15 &g = gost12_15::getInstance();
+    for (int op = 0; op < tunedOperationCount; op++) {
+        for (int s = 0; s < sizeClassCount; s++) {
+            g.setEngineChoice(static_cast<tunedOperation>(op), static_cast<sizeClass>(s), choices[op][s]);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    tuned = true;
+    return true;
+}
+
+
+/**
+* \brief    .
+*
+* \param [in] cacheFile     .
+* \return  false   .
+*/
+bool autotuner::save(const std::string& cacheFile) {
+    std::ofstream out(cacheFile.c_str(), std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+
+    out << cacheHeader << "\n";
+    out << "signature " << cpuSignature() << "\n";
+    out << describe();
+    return static_cast<bool>(out);
+}
+
+
+/**
+* \brief          .
+*
+* \param [in] choice    "table:4", "compact:1"  "table" ( 4).
+* \return  false,     (  ).
+*/
+bool autotuner::setOverride(const std::string& choice) {
+    engineChoice parsed;
+    if (!parseChoice(choice, parsed)) {
+        return false;
+    }
+
+    gost12_15 &g = gost12_15::getInstance();
+    for (int op = 0; op < tunedOperationCount; op++) {
+        for (int s = 0; s < sizeClassCount; s++) {
+            g.setEngineChoice(static_cast<tunedOperation>(op), static_cast<sizeClass>(s), parsed);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    tuned = true;
+    return true;
+}
+
+
+/**
+* \brief     .
+*
+* :   GOST12_15_ENGINE,    cacheFile,  
+*     cacheFile.        ,
+*     runBenchmarks.
+*
+* \param [in] cacheFile      (     ).
+* \return  true,     (  ,    ).
+*/
+bool autotuner::tune(const std::string& cacheFile) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tuned) {
+            return true;
+        }
+    }
+
+    std::string forced = getEnvironment("GOST12_15_ENGINE");
+    if (!forced.empty() && setOverride(forced)) {
+        return true;
+    }
+
+    if (!cacheFile.empty() && load(cacheFile)) {
+        return true;
+    }
+
+    runBenchmarks();
+    if (!cacheFile.empty()) {
+        save(cacheFile);
+    }
+    return false;
+}
+
+
+/**
+* \brief     .
+*
+*  ,     tune  (,   OpenSSL):
+* GOST12_15_ENGINE   , GOST12_15_TUNE_FILE     tune.
+*      ,        .
+*
+* \return  true,        .
+*/
+bool autotuner::tuneFromEnvironment() {
+    std::string forced = getEnvironment("GOST12_15_ENGINE");
+    if (!forced.empty()) {
+        return setOverride(forced);
+    }
+
+    std::string cacheFile = getEnvironment("GOST12_15_TUNE_FILE");
+    if (cacheFile.empty()) {
+        return false;
+    }
+    return tune(cacheFile);
+}
+
+
+/**
+* \brief        .
+*
+* \return    "<> < > <>:<>".
+*/
+std::string autotuner::describe() {
+    gost12_15 &g = gost12_15::getInstance();
+    std::ostringstream out;
+
+    for (int op = 0; op < tunedOperationCount; op++) {
+        for (int s = 0; s < sizeClassCount; s++) {
+            engineChoice choice = g.getEngineChoice(static_cast<tunedOperation>(op), static_cast<sizeClass>(s));
+            out << operationNames[op] << " " << sizeNames[s] << " " << formatChoice(choice) << "\n";
+        }
+    }
+
+    return out.str();
+}
@@ -0,0 +1,47 @@
+#ifndef _AUTOTUNER_H_
+#define _AUTOTUNER_H_
+
+#include <string>
+#include <mutex>
+
+#include "gost12_15.h"
+
+/**
+* \brief      .
+*
+*    (tunedOperation)    (sizeClass)   
+*  ,     gost12_15::setEngineChoice.
+*        ,    
+*       .
+*   GOST12_15_ENGINE (, "table:4"  "compact:1")  
+* setOverride      .  GOST12_15_TUNE_FILE 
+*        (. tuneFromEnvironment).
+*/
+class autotuner {
+public:
+    static autotuner& getInstance() {
+        static autotuner a;
+        return a;
+    }
+
+    bool tune(const std::string& cacheFile);
+    bool tuneFromEnvironment();
+    void runBenchmarks();
+    bool load(const std::string& cacheFile);
+    bool save(const std::string& cacheFile);
+    bool setOverride(const std::string& choice);
+
+    static std::string cpuSignature();
+    static std::string describe();
+private:
+    autotuner() {}
+    autotuner(const autotuner&) = delete;
+    autotuner& operator=(const autotuner&) = delete;
+
+    double measure(tunedOperation operation, sizeClass size, engineChoice choice);
+
+    std::mutex mutex;
+    bool tuned = false;
+};
+
+#endif
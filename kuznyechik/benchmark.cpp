@@ -0,0 +1,619 @@
+#include "benchmark.h"
+
+#include <chrono>
+#include <random>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+#include "gost12_15.h"
+#include "keyScheduleCache.h"
+#include "jobScheduler.h"
+#include "magma.h"
+#include "segmentedContainer.h"
+#include "bufferPool.h"
+#include "blockCipher.h"
+#include "cmacKdf.h"
+
+
+namespace {
+
+typedef std::chrono::steady_clock benchmarkClock;
+
+
+double secondsSince(benchmarkClock::time_point start) {
+    return std::chrono::duration<double>(benchmarkClock::now() - start).count();
+}
+
+
+/**
+* \brief     (  )    .
+*
+*    pressure,       (  
+*  ),   ,         .
+*    .  decrypt  true,  
+*  decryptBlocks (messageSize    16).
+*
+* \return    /.
+*/
+double gammaThroughput(const expandedKey& key, size_t messageSize, int messageCount, vector<uint8_t>* pressure,
+                       bool decrypt = false) {
+    gost12_15 &g = gost12_15::getInstance();
+    vector<uint8_t> message(messageSize, 0x5a);
+    uint8_t sync[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    double seconds = 0;
+    volatile uint8_t sink = 0;
+
+    for (int i = 0; i < messageCount; i++) {
+        if (pressure) {
+            for (size_t j = 0; j < pressure->size(); j += 64) {
+                (*pressure)[j]++;
+            }
+            sink = sink + (*pressure)[i % pressure->size()];
+        }
+
+        benchmarkClock::time_point start = benchmarkClock::now();
+        if (decrypt) {
+            g.decryptBlocks(key, message.data(), message.data(), message.size() / 16);
+        }
+        else {
+            g.gammaCryptionBlocks(key, sync, 1, message.data(), message.data(), message.size());
+        }
+        seconds += secondsSince(start);
+    }
+
+    return static_cast<double>(messageSize) * messageCount / seconds / 1e6;
+}
+
+
+/**
+* \brief    page fault    .
+*/
+uint64_t pageFaults() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return counters.PageFaultCount;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(usage.ru_minflt) + static_cast<uint64_t>(usage.ru_majflt);
+#endif
+}
+
+
+std::atomic<uint64_t> heapAllocations(0);
+
+
+/**
+* \brief   std::vector,      (heapAllocations).
+*/
+template <class T>
+struct countingAllocator {
+    typedef T value_type;
+
+    countingAllocator() {}
+
+    template <class U>
+    countingAllocator(const countingAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t) {
+        ::operator delete(p);
+    }
+};
+
+
+template <class T, class U>
+bool operator==(const countingAllocator<T>&, const countingAllocator<U>&) {
+    return true;
+}
+
+
+template <class T, class U>
+bool operator!=(const countingAllocator<T>&, const countingAllocator<U>&) {
+    return false;
+}
+
+
+void fillKey(vector<uint8_t>& key, uint32_t number) {
+    for (size_t i = 0; i < key.size(); i++) {
+        key[i] = static_cast<uint8_t>(number >> (8 * (i % 4))) ^ static_cast<uint8_t>(i * 0x3b);
+    }
+}
+
+}
+
+
+/**
+* \brief      (  ).
+*
+*  generatingRoundKeys, expandKey  keyScheduleCache  
+*     (     ).
+*/
+void keyScheduleBenchmark() {
+    cout << "Key schedule benchmark" << endl;
+    cout << "------------------------" << endl;
+
+    gost12_15 &g = gost12_15::getInstance();
+    vector<uint8_t> key(32, 0);
+    expandedKey expanded;
+
+    const int slowKeys = 2000;
+    benchmarkClock::time_point start = benchmarkClock::now();
+    for (int i = 0; i < slowKeys; i++) {
+        fillKey(key, i);
+        vector<vector<uint8_t>> roundKeys = g.generatingRoundKeys(key);
+        expanded = g.packRoundKeys(roundKeys);
+    }
+    double slowRate = slowKeys / secondsSince(start);
+
+    const int fastKeys = 200000;
+    start = benchmarkClock::now();
+    for (int i = 0; i < fastKeys; i++) {
+        fillKey(key, i);
+        g.expandKey(key.data(), expanded);
+    }
+    double fastRate = fastKeys / secondsSince(start);
+
+    keyScheduleCache cache(1024);
+    start = benchmarkClock::now();
+    for (int i = 0; i < fastKeys; i++) {
+        fillKey(key, i % 512);
+        cache.get(key.data(), expanded);
+    }
+    double hitRate = fastKeys / secondsSince(start);
+
+    start = benchmarkClock::now();
+    for (int i = 0; i < fastKeys; i++) {
+        fillKey(key, 1000000 + i % 4096);
+        cache.get(key.data(), expanded);
+    }
+    double missRate = fastKeys / secondsSince(start);
+
+    keyCacheStatistics stats = cache.statistics();
+
+    cout << std::dec;
+    cout << "generatingRoundKeys, keys/s: " << static_cast<uint64_t>(slowRate) << endl;
+    cout << "expandKey, keys/s: " << static_cast<uint64_t>(fastRate) << endl;
+    cout << "keyScheduleCache (hits), keys/s: " << static_cast<uint64_t>(hitRate) << endl;
+    cout << "keyScheduleCache (misses), keys/s: " << static_cast<uint64_t>(missRate) << endl;
+    cout << "Cache hits: " << stats.hits << ", misses: " << stats.misses
+         << ", evictions: " << stats.evictions << endl;
+    cout << "------------------------" << endl;
+}
+
+
+/**
+* \brief            .
+*
+*  engineTable  64   , engineCompact   8   .
+*   ( )   .
+*/
+void compactTableBenchmark() {
+    cout << "Compact table benchmark" << endl;
+    cout << "------------------------" << endl;
+
+    gost12_15 &g = gost12_15::getInstance();
+    vector<uint8_t> key(32, 0);
+    fillKey(key, 7);
+    expandedKey expanded;
+    g.expandKey(key.data(), expanded);
+
+    engineChoice previous[tunedOperationCount][sizeClassCount];
+    for (int op = 0; op < tunedOperationCount; op++) {
+        for (int s = 0; s < sizeClassCount; s++) {
+            previous[op][s] = g.getEngineChoice(static_cast<tunedOperation>(op), static_cast<sizeClass>(s));
+        }
+    }
+    vector<uint8_t> pressure(8 * 1024 * 1024, 0);
+    const blockEngine engines[] = { engineTable, engineCompact };
+    const char* names[] = { "table (64 KB per direction)", "compact (8 KB per direction)" };
+    const size_t sizes[] = { 64, 256, 4096 };
+
+    cout << std::dec;
+    for (int e = 0; e < 2; e++) {
+        g.setEngine(engines[e]);
+        for (int s = 0; s < 3; s++) {
+            double hot = gammaThroughput(expanded, sizes[s], 20000, nullptr);
+            double cold = gammaThroughput(expanded, sizes[s], 200, &pressure);
+            cout << names[e] << ", " << sizes[s] << " bytes: hot " << static_cast<int>(hot)
+                 << " MB/s, under cache pressure " << static_cast<int>(cold) << " MB/s" << endl;
+        }
+        double hotDecrypt = gammaThroughput(expanded, 4096, 2000, nullptr, true);
+        double coldDecrypt = gammaThroughput(expanded, 4096, 200, &pressure, true);
+        cout << names[e] << ", decryptBlocks 4096 bytes: hot " << static_cast<int>(hotDecrypt)
+             << " MB/s, under cache pressure " << static_cast<int>(coldDecrypt) << " MB/s" << endl;
+    }
+    for (int op = 0; op < tunedOperationCount; op++) {
+        for (int s = 0; s < sizeClassCount; s++) {
+            g.setEngineChoice(static_cast<tunedOperation>(op), static_cast<sizeClass>(s), previous[op][s]);
+        }
+    }
+
+    cout << "------------------------" << endl;
+}
+
+
+/**
+* \brief        .
+*
+*  :    ( 4 )     (16   2 ).
+*        . 
+*    .
+*/
+void jobSchedulerBenchmark() {
+    cout << "Job scheduler benchmark" << endl;
+    cout << "------------------------" << endl;
+
+    gost12_15 &g = gost12_15::getInstance();
+    vector<uint8_t> key(32, 0);
+    fillKey(key, 11);
+    expandedKey expanded;
+    g.expandKey(key.data(), expanded);
+
+    std::mt19937 random(2024);
+    const int smallFiles = 4000;
+    const int largeFiles = 40;
+    vector<vector<uint8_t>> files;
+    for (int i = 0; i < smallFiles + largeFiles; i++) {
+        double exponent = i < smallFiles ? 5 + 7.0 * (random() % 1000) / 1000 : 14 + 7.0 * (random() % 1000) / 1000;
+        files.push_back(vector<uint8_t>(static_cast<size_t>(pow(2.0, exponent)), static_cast<uint8_t>(i)));
+    }
+    std::shuffle(files.begin(), files.end(), random);
+
+    size_t totalBytes = 0;
+    for (size_t i = 0; i < files.size(); i++) {
+        totalBytes += files[i].size();
+    }
+
+    vector<vector<uint8_t>> sequential(files.size());
+    vector<uint8_t> sequentialImito(files.size() * 8);
+    benchmarkClock::time_point start = benchmarkClock::now();
+    for (size_t i = 0; i < files.size(); i++) {
+        uint8_t sync[8] = { 0x12, 0x34, 0x56, 0x78, 0x90, 0xab, 0xce, static_cast<uint8_t>(i) };
+        sequential[i].resize(files[i].size());
+        g.gammaCryptionBlocks(expanded, sync, 1, files[i].data(), sequential[i].data(), files[i].size());
+        g.imitoGenerationBlocks(expanded, sequential[i].data(), sequential[i].size(), &sequentialImito[i * 8], 8);
+    }
+    double sequentialSeconds = secondsSince(start);
+
+    vector<vector<uint8_t>> scheduled(files.size());
+    vector<uint8_t> scheduledImito(files.size() * 8);
+    vector<cryptoJob> jobs(files.size());
+    std::atomic<size_t> completed(0);
+    for (size_t i = 0; i < files.size(); i++) {
+        uint8_t sync[8] = { 0x12, 0x34, 0x56, 0x78, 0x90, 0xab, 0xce, static_cast<uint8_t>(i) };
+        scheduled[i].resize(files[i].size());
+        jobs[i].key = expanded;
+        memcpy(jobs[i].sync, sync, sizeof(sync));
+        jobs[i].in = files[i].data();
+        jobs[i].out = scheduled[i].data();
+        jobs[i].length = files[i].size();
+        jobs[i].imito = &scheduledImito[i * 8];
+        jobs[i].imitoLength = 8;
+        jobs[i].completion = [&completed](const cryptoJob&) { completed++; };
+    }
+
+    jobScheduler scheduler;
+    start = benchmarkClock::now();
+    scheduler.submit(jobs.data(), jobs.size());
+    scheduler.wait();
+    double scheduledSeconds = secondsSince(start);
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < files.size(); i++) {
+        if (scheduled[i] != sequential[i] || memcmp(&scheduledImito[i * 8], &sequentialImito[i * 8], 8) != 0) {
+            mismatches++;
+        }
+    }
+
+    schedulerStatistics stats = scheduler.statistics();
+
+    cout << std::dec;
+    cout << "Files: " << files.size() << ", bytes: " << totalBytes << endl;
+    cout << "Sequential, MB/s: " << static_cast<int>(totalBytes / sequentialSeconds / 1e6) << endl;
+    cout << "jobScheduler (" << scheduler.threadCount() << " threads), MB/s: "
+         << static_cast<int>(totalBytes / scheduledSeconds / 1e6) << endl;
+    cout << "Chunk tasks: " << stats.chunkTasks << ", packed tasks: " << stats.packedTasks
+         << ", steals: " << stats.steals << endl;
+    cout << "Completed: " << completed << ", mismatches: " << mismatches << endl;
+    cout << "------------------------" << endl;
+}
+
+
+/**
+* \brief           .
+*
+*     ,   gost12_15.
+*/
+void magmaBenchmark() {
+    cout << "Magma benchmark" << endl;
+    cout << "------------------------" << endl;
+
+    gost12_15 &g = gost12_15::getInstance();
+    magma &m = magma::getInstance();
+    vector<uint8_t> key(32, 0);
+    fillKey(key, 13);
+    expandedKey kuznyechikKey;
+    g.expandKey(key.data(), kuznyechikKey);
+    magmaKey magmaExpanded;
+    m.expandKey(key.data(), magmaExpanded);
+
+    const size_t sizes[] = { 64, 4096, 1024 * 1024 };
+    const size_t totalBytes = 32 * 1024 * 1024;
+    uint8_t sync[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    uint8_t imito[8];
+
+    cout << std::dec;
+    for (int s = 0; s < 3; s++) {
+        vector<uint8_t> message(sizes[s], 0x5a);
+        size_t rounds = totalBytes / sizes[s];
+        double rates[4];
+
+        benchmarkClock::time_point start = benchmarkClock::now();
+        for (size_t i = 0; i < rounds; i++) {
+            g.gammaCryptionBlocks(kuznyechikKey, sync, 1, message.data(), message.data(), message.size());
+        }
+        rates[0] = totalBytes / secondsSince(start) / 1e6;
+
+        start = benchmarkClock::now();
+        for (size_t i = 0; i < rounds; i++) {
+            m.gammaCryptionBlocks(magmaExpanded, sync, 0, message.data(), message.data(), message.size());
+        }
+        rates[1] = totalBytes / secondsSince(start) / 1e6;
+
+        start = benchmarkClock::now();
+        for (size_t i = 0; i < rounds; i++) {
+            g.imitoGenerationBlocks(kuznyechikKey, message.data(), message.size(), imito, 8);
+        }
+        rates[2] = totalBytes / secondsSince(start) / 1e6;
+
+        start = benchmarkClock::now();
+        for (size_t i = 0; i < rounds; i++) {
+            m.imitoGenerationBlocks(magmaExpanded, message.data(), message.size(), imito, 8);
+        }
+        rates[3] = totalBytes / secondsSince(start) / 1e6;
+
+        cout << sizes[s] << " bytes, CTR MB/s: kuznyechik " << static_cast<int>(rates[0])
+             << ", magma " << static_cast<int>(rates[1]) << "; MAC MB/s: kuznyechik "
+             << static_cast<int>(rates[2]) << ", magma " << static_cast<int>(rates[3]) << endl;
+    }
+
+    cout << "------------------------" << endl;
+}
+
+
+/**
+* \brief     CTR +        .
+*
+*  ,    4    :    
+*     .
+*/
+void containerBenchmark() {
+    cout << "Segmented container benchmark" << endl;
+    cout << "------------------------" << endl;
+
+    gost12_15 &g = gost12_15::getInstance();
+    vector<uint8_t> key(32, 0);
+    fillKey(key, 17);
+    expandedKey expanded;
+    g.expandKey(key.data(), expanded);
+
+    vector<uint8_t> data(16 * 1024 * 1024, 0x3c);
+    vector<uint8_t> encrypted(data.size());
+    uint8_t sync[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    uint8_t imito[16];
+    const int reads = 200;
+    const size_t readSize = 4096;
+
+    benchmarkClock::time_point start = benchmarkClock::now();
+    g.gammaCryptionBlocks(expanded, sync, 1, data.data(), encrypted.data(), data.size());
+    g.imitoGenerationBlocks(expanded, encrypted.data(), encrypted.size(), imito, sizeof(imito));
+    double singlePass = data.size() / secondsSince(start) / 1e6;
+
+    start = benchmarkClock::now();
+    for (int i = 0; i < 4; i++) {
+        g.imitoVerify(expanded, encrypted.data(), encrypted.size(), imito, sizeof(imito));
+    }
+    double singleReadMs = secondsSince(start) / 4 * 1e3;
+
+    segmentedContainer container(algorithmKuznyechik, key.data());
+    vector<uint8_t> sealed;
+    uint64_t faults = pageFaults();
+    bufferPoolStatistics pool = bufferPool::getInstance().statistics();
+    start = benchmarkClock::now();
+    bool sealedOk = container.seal(data.data(), data.size(), sealed);
+    double sealRate = data.size() / secondsSince(start) / 1e6;
+
+    vector<uint8_t> opened;
+    start = benchmarkClock::now();
+    bool openedOk = container.open(sealed.data(), sealed.size(), opened) && opened == data;
+    double openRate = data.size() / secondsSince(start) / 1e6;
+
+    std::mt19937 random(7);
+    vector<uint8_t> chunk(readSize);
+    bool readOk = true;
+    start = benchmarkClock::now();
+    for (int i = 0; i < reads; i++) {
+        uint64_t offset = random() % (data.size() - readSize);
+        readOk = container.read(sealed.data(), sealed.size(), offset, chunk.data(), chunk.size()) && readOk;
+    }
+    double containerReadMs = secondsSince(start) / reads * 1e3;
+    faults = pageFaults() - faults;
+    bufferPoolStatistics poolAfter = bufferPool::getInstance().statistics();
+
+    cout << std::dec;
+    cout << "Single pass CTR + imito, MB/s: " << static_cast<int>(singlePass) << endl;
+    cout << "Container seal, MB/s: " << static_cast<int>(sealRate) << ", open, MB/s: " << static_cast<int>(openRate)
+         << ", overhead bytes: " << sealed.size() - data.size() << endl;
+    cout << "Random 4 KB read, ms: whole file verify " << singleReadMs << ", container " << containerReadMs << endl;
+    cout << "Container page faults: " << faults << ", pool buffers: "
+         << poolAfter.acquisitions - pool.acquisitions << ", system allocations: "
+         << poolAfter.systemAllocations - pool.systemAllocations << endl;
+    cout << "Container round trip: " << (sealedOk && openedOk && readOk ? "ok" : "FAILED") << endl;
+    cout << "------------------------" << endl;
+}
+
+
+/**
+* \brief                .
+*
+*      4 .       
+* page fault;         ,    
+* ,   ,     .   
+*      ,   page fault  
+*  .
+*/
+void bufferPoolBenchmark() {
+    cout << "Buffer pool benchmark" << endl;
+    cout << "------------------------" << endl;
+
+    vector<uint8_t> key(32, 0);
+    fillKey(key, 19);
+    blockCipher cipher(algorithmKuznyechik, key.data());
+
+    const size_t requestSize = 4 * 1024 * 1024;
+    const int requestsPerThread = 16;
+    unsigned threadCount = std::thread::hardware_concurrency();
+    threadCount = threadCount < 2 ? 2 : (threadCount > 8 ? 8 : threadCount);
+    vector<uint8_t> input(requestSize, 0x42);
+    uint8_t sync[8] = { 8, 7, 6, 5, 4, 3, 2, 1 };
+    bufferPool &pool = bufferPool::getInstance();
+    const char* names[] = { "vector per request", "bufferPool", "bufferPool + huge pages" };
+
+    cout << std::dec;
+    for (int variant = 0; variant < 3; variant++) {
+        pool.setHugePages(variant == 2);
+        std::atomic<uint64_t> sink(0);
+        bufferPoolStatistics before = pool.statistics();
+        uint64_t heapBefore = heapAllocations.load();
+        uint64_t faults = pageFaults();
+
+        benchmarkClock::time_point start = benchmarkClock::now();
+        vector<std::thread> threads;
+        for (unsigned t = 0; t < threadCount; t++) {
+            threads.push_back(std::thread([&, variant]() {
+                for (int r = 0; r < requestsPerThread; r++) {
+                    if (variant == 0) {
+                        vector<uint8_t, countingAllocator<uint8_t>> out(requestSize);
+                        cipher.ctrCrypt(sync, 1, input.data(), out.data(), out.size());
+                        sink += out[r];
+                    }
+                    else {
+                        poolBuffer out = cipher.ctrCrypt(sync, 1, input.data(), requestSize);
+                        sink += out.data()[r];
+                    }
+                }
+            }));
+        }
+        for (size_t t = 0; t < threads.size(); t++) {
+            threads[t].join();
+        }
+        double seconds = secondsSince(start);
+
+        faults = pageFaults() - faults;
+        bufferPoolStatistics after = pool.statistics();
+
+        cout << names[variant] << " (" << threadCount << " threads), MB/s: "
+             << static_cast<int>(static_cast<double>(requestSize) * requestsPerThread * threadCount / seconds / 1e6)
+             << ", page faults: " << faults;
+        if (variant == 0) {
+            cout << ", heap allocations: " << heapAllocations.load() - heapBefore;
+        }
+        else {
+            cout << ", system allocations: " << after.systemAllocations - before.systemAllocations
+                 << ", reused: " << after.reuses - before.reuses
+                 << ", huge page regions: " << after.hugePageAllocations - before.hugePageAllocations;
+        }
+        cout << endl;
+    }
+    pool.setHugePages(false);
+
+    cout << "------------------------" << endl;
+}
+
+
+/**
+* \brief        32    -.
+*
+* :  -  imitoGeneration     (  KDF),
+* cmacKdf::derive     cmacKdf::deriveBatch    .
+*/
+void kdfBenchmark() {
+    cout << "Key derivation benchmark" << endl;
+    cout << "------------------------" << endl;
+
+    gost12_15 &g = gost12_15::getInstance();
+    vector<uint8_t> key(32, 0);
+    fillKey(key, 23);
+
+    const size_t count = 20000;
+    const size_t legacyCount = 2000;
+    const uint8_t label[] = { 't', 'e', 'n', 'a', 'n', 't' };
+    vector<uint8_t> contexts(count * 8);
+    for (size_t i = 0; i < count; i++) {
+        for (int j = 0; j < 8; j++) {
+            contexts[i * 8 + j] = static_cast<uint8_t>(i >> (56 - 8 * j));
+        }
+    }
+    vector<uint8_t> keys(count * 32);
+    volatile uint8_t sink = 0;
+
+    benchmarkClock::time_point start = benchmarkClock::now();
+    for (size_t i = 0; i < legacyCount; i++) {
+        for (uint8_t block = 1; block <= 2; block++) {
+            vector<uint8_t> message = { 0, 0, 0, block };
+            message.insert(message.end(), label, label + sizeof(label));
+            message.push_back(0x00);
+            message.insert(message.end(), contexts.begin() + i * 8, contexts.begin() + i * 8 + 8);
+            message.insert(message.end(), { 0, 0, 1, 0 });
+            vector<uint8_t> imito = g.imitoGeneration(message, g.generatingRoundKeys(key));
+            sink = sink ^ imito[0];
+        }
+    }
+    double legacyRate = legacyCount / secondsSince(start);
+
+    cmacKdf kdf(algorithmKuznyechik, key.data());
+    start = benchmarkClock::now();
+    for (size_t i = 0; i < count; i++) {
+        kdf.derive(label, sizeof(label), contexts.data() + i * 8, 8, keys.data() + i * 32, 32);
+    }
+    double singleRate = count / secondsSince(start);
+    vector<uint8_t> singleKeys(keys);
+
+    vector<kdfRequest> requests(count);
+    for (size_t i = 0; i < count; i++) {
+        requests[i] = { label, sizeof(label), contexts.data() + i * 8, 8, keys.data() + i * 32, 32 };
+    }
+    start = benchmarkClock::now();
+    kdf.deriveBatch(requests.data(), requests.size());
+    double batchRate = count / secondsSince(start);
+
+    cout << std::dec << "Derivations/s: round keys + imitoGeneration " << static_cast<int>(legacyRate)
+         << ", derive " << static_cast<int>(singleRate) << ", deriveBatch " << static_cast<int>(batchRate) << endl;
+    cout << "Batch matches single derivations: " << (singleKeys == keys ? "yes" : "no") << endl;
+
+    cout << "------------------------" << endl;
+}
@@ -0,0 +1,12 @@
+#ifndef _BENCHMARK_H_
+#define _BENCHMARK_H_
+
+void keyScheduleBenchmark();
+void compactTableBenchmark();
+void jobSchedulerBenchmark();
+void magmaBenchmark();
+void containerBenchmark();
+void bufferPoolBenchmark();
+void kdfBenchmark();
+
+#endif
@@ -0,0 +1,318 @@
+#include "blockCipher.h"
+
+#include <cstring>
+
+#include "blockModes.h"
+#include "gostStatistics.h"
+
+
+/**
+* \brief :     .
+*
+*      initRoundConsts.
+*
+* \param [in] algorithm  .
+* \param [in] key    32 .
+*/
+blockCipher::blockCipher(cipherAlgorithm algorithm, const uint8_t* key) : algorithm(algorithm) {
+    memset(&kuznyechikKey, 0, sizeof(kuznyechikKey));
+    memset(&kuznyechikInverse, 0, sizeof(kuznyechikInverse));
+    memset(&magmaForward, 0, sizeof(magmaForward));
+    memset(&magmaInverse, 0, sizeof(magmaInverse));
+
+    if (algorithm == algorithmMagma) {
+        magma &m = magma::getInstance();
+        m.expandKey(key, magmaForward);
+        magmaEngine(m).decryptKey(magmaForward, magmaInverse);
+    }
+    else {
+        gost12_15 &g = gost12_15::getInstance();
+        g.expandKey(key, kuznyechikKey);
+        kuznyechikEngine(g).decryptKey(kuznyechikKey, kuznyechikInverse);
+    }
+}
+
+
+/**
+* \brief :   .
+*/
+blockCipher::~blockCipher() {
+    volatile uint8_t* p = reinterpret_cast<volatile uint8_t*>(&kuznyechikKey);
+    for (size_t i = 0; i < sizeof(kuznyechikKey); i++) {
+        p[i] = 0;
+    }
+    p = reinterpret_cast<volatile uint8_t*>(&kuznyechikInverse);
+    for (size_t i = 0; i < sizeof(kuznyechikInverse); i++) {
+        p[i] = 0;
+    }
+    p = reinterpret_cast<volatile uint8_t*>(&magmaForward);
+    for (size_t i = 0; i < sizeof(magmaForward); i++) {
+        p[i] = 0;
+    }
+    p = reinterpret_cast<volatile uint8_t*>(&magmaInverse);
+    for (size_t i = 0; i < sizeof(magmaInverse); i++) {
+        p[i] = 0;
+    }
+}
+
+
+cipherAlgorithm blockCipher::getAlgorithm() const {
+    return algorithm;
+}
+
+
+size_t blockCipher::getBlockSize() const {
+    return algorithm == algorithmMagma ? magmaEngine::blockSize : kuznyechikEngineBase::blockSize;
+}
+
+
+/**
+* \brief           .
+*
+*  f(engine, forwardKey, inverseKey, std::integral_constant<size_t, N>()).
+*        gost12_15::getEngineChoice,   
+* ,    .
+*
+* \param [in] operation   (   ).
+* \param [in] length     .
+* \param [in] f    .
+*/
+template <class F>
+void blockCipher::dispatch(tunedOperation operation, size_t length, F&& f) const {
+    gost12_15 &g = gost12_15::getInstance();
+    engineChoice choice = g.getEngineChoice(operation, gost12_15::getSizeClass(length));
+
+    if (algorithm == algorithmMagma) {
+        magmaEngine engine;
+        withInterleave(choice.interleave, [&](auto lanes) { f(engine, magmaForward, magmaInverse, lanes); });
+    }
+    else {
+        withKuznyechikEngine(g, choice, [&](const auto& engine, auto lanes) {
+            f(engine, kuznyechikKey, kuznyechikInverse, lanes);
+        });
+    }
+}
+
+
+/**
+* \brief     (  ).
+*
+* \param [in] in   .
+* \param [out] out    (   in).
+* \param [in] blockCount   .
+*/
+void blockCipher::ecbEncrypt(const uint8_t* in, uint8_t* out, size_t blockCount) const {
+    GOST_STAT_ADD(counterBlocksEncrypted, blockCount);
+
+    dispatch(tunedGamma, blockCount * getBlockSize(), [&](const auto& engine, const auto& key, const auto&, auto lanes) {
+        ::ecbEncrypt<decltype(lanes)::value>(engine, key, in, out, blockCount);
+    });
+}
+
+
+/**
+* \brief     (  ).
+*
+* \param [in] in   .
+* \param [out] out    (   in).
+* \param [in] blockCount   .
+*/
+void blockCipher::ecbDecrypt(const uint8_t* in, uint8_t* out, size_t blockCount) const {
+    GOST_STAT_ADD(counterBlocksDecrypted, blockCount);
+
+    dispatch(tunedGamma, blockCount * getBlockSize(), [&](const auto& engine, const auto&, const auto& inverse, auto lanes) {
+        ::ecbDecrypt<decltype(lanes)::value>(engine, inverse, in, out, blockCount);
+    });
+}
+
+
+/**
+* \brief   ( CTR).
+*
+* \param [in] sync      .
+* \param [in] firstCounter    .
+* \param [in] in   .
+* \param [out] out    (   in).
+* \param [in] length     .
+*/
+void blockCipher::ctrCrypt(const uint8_t* sync, uint64_t firstCounter, const uint8_t* in, uint8_t* out,
+                           size_t length) const {
+    GOST_STAT_ADD(counterGammaBytes, length);
+    GOST_STAT_TIMER(operationGamma);
+
+    dispatch(tunedGamma, length, [&](const auto& engine, const auto& key, const auto&, auto lanes) {
+        ::ctrCrypt<decltype(lanes)::value>(engine, key, sync, firstCounter, in, out, length);
+    });
+}
+
+
+/**
+* \brief   ( CTR)     bufferPool.
+*
+*    :        
+*          page fault.
+*
+* \param [in] sync      .
+* \param [in] firstCounter    .
+* \param [in] in   .
+* \param [in] length     .
+* \return      length.
+*/
+poolBuffer blockCipher::ctrCrypt(const uint8_t* sync, uint64_t firstCounter, const uint8_t* in, size_t length) const {
+    poolBuffer out(length);
+    ctrCrypt(sync, firstCounter, in, out.data(), length);
+    return out;
+}
+
+
+/**
+* \brief     CBC.
+*
+* \param [in,out] iv     ;     .
+* \param [in] in   .
+* \param [out] out    (   in).
+* \param [in] blockCount   .
+*/
+void blockCipher::cbcEncrypt(uint8_t* iv, const uint8_t* in, uint8_t* out, size_t blockCount) const {
+    GOST_STAT_ADD(counterBlocksEncrypted, blockCount);
+
+    if (algorithm == algorithmMagma) {
+        ::cbcEncrypt(magmaEngine(), magmaForward, iv, in, out, blockCount);
+    }
+    else {
+        gost12_15 &g = gost12_15::getInstance();
+        withKuznyechikPolicy(g, g.getEngineChoice(tunedImito, gost12_15::getSizeClass(blockCount * getBlockSize())).engine,
+                             [&](const auto& engine) { ::cbcEncrypt(engine, kuznyechikKey, iv, in, out, blockCount); });
+    }
+}
+
+
+/**
+* \brief     CBC.
+*
+* \param [in,out] iv     ;     .
+* \param [in] in   .
+* \param [out] out    (   in).
+* \param [in] blockCount   .
+*/
+void blockCipher::cbcDecrypt(uint8_t* iv, const uint8_t* in, uint8_t* out, size_t blockCount) const {
+    GOST_STAT_ADD(counterBlocksDecrypted, blockCount);
+
+    dispatch(tunedGamma, blockCount * getBlockSize(), [&](const auto& engine, const auto&, const auto& inverse, auto lanes) {
+        ::cbcDecrypt<decltype(lanes)::value>(engine, inverse, iv, in, out, blockCount);
+    });
+}
+
+
+/**
+* \brief   .
+*
+* \param [in] data  .
+* \param [in] length     .
+* \param [out] imito  .
+* \param [in] imitoLength      (   ).
+*/
+void blockCipher::imito(const uint8_t* data, size_t length, uint8_t* imito, size_t imitoLength) const {
+    this->imito(nullptr, data, length, imito, imitoLength);
+}
+
+
+/**
+* \brief      prefix   (. cmacCompute).
+*
+* \param [in] prefix     (  )  nullptr.
+* \param [in] data  .
+* \param [in] length     .
+* \param [out] imito  .
+* \param [in] imitoLength      (   ).
+*/
+void blockCipher::imito(const uint8_t* prefix, const uint8_t* data, size_t length, uint8_t* imito,
+                        size_t imitoLength) const {
+    GOST_STAT_ADD(counterImitoBytes, length);
+    GOST_STAT_TIMER(operationImito);
+
+    if (algorithm == algorithmMagma) {
+        cmacCompute(magmaEngine(), magmaForward, prefix, data, length, imito, imitoLength);
+    }
+    else {
+        gost12_15 &g = gost12_15::getInstance();
+        withKuznyechikPolicy(g, g.getEngineChoice(tunedImito, gost12_15::getSizeClass(length)).engine, [&](const auto& engine) {
+            cmacCompute(engine, kuznyechikKey, prefix, data, length, imito, imitoLength);
+        });
+    }
+}
+
+
+/**
+* \brief     ,     .
+*
+* \param [in] data  .
+* \param [in] length     .
+* \param [in] imito   .
+* \param [in] imitoLength      ( 1   ).
+* \return  true,   ; false    .
+*/
+bool blockCipher::imitoVerify(const uint8_t* data, size_t length, const uint8_t* imito, size_t imitoLength) const {
+    if (imitoLength == 0 || imitoLength > getBlockSize()) {
+        return false;
+    }
+
+    uint8_t expected[16];
+    this->imito(data, length, expected, imitoLength);
+
+    uint8_t difference = 0;
+    for (size_t i = 0; i < imitoLength; i++) {
+        difference |= expected[i] ^ imito[i];
+    }
+
+    return difference == 0;
+}
+
+
+/**
+* \brief        (. cmacAbsorb).
+*
+*     ,    .
+*
+* \param [in,out] state      (   ).
+* \param [in] blocks   .
+* \param [in] blockCount   .
+*/
+void blockCipher::imitoAbsorb(uint8_t* state, const uint8_t* blocks, size_t blockCount) const {
+    GOST_STAT_ADD(counterImitoBytes, blockCount * getBlockSize());
+
+    if (algorithm == algorithmMagma) {
+        cmacAbsorb(magmaEngine(), magmaForward, state, blocks, blockCount);
+    }
+    else {
+        gost12_15 &g = gost12_15::getInstance();
+        withKuznyechikPolicy(g, g.getEngineChoice(tunedImito, sizeLarge).engine, [&](const auto& engine) {
+            cmacAbsorb(engine, kuznyechikKey, state, blocks, blockCount);
+        });
+    }
+}
+
+
+/**
+* \brief        (. cmacFinish).
+*
+* \param [in] state    imitoAbsorb.
+* \param [in] last    .
+* \param [in] tail     ( 0   ).
+* \param [out] imito  .
+* \param [in] imitoLength      (   ).
+*/
+void blockCipher::imitoFinish(const uint8_t* state, const uint8_t* last, size_t tail, uint8_t* imito,
+                              size_t imitoLength) const {
+    GOST_STAT_ADD(counterImitoBytes, tail);
+
+    if (algorithm == algorithmMagma) {
+        cmacFinish(magmaEngine(), magmaForward, state, last, tail, imito, imitoLength);
+    }
+    else {
+        gost12_15 &g = gost12_15::getInstance();
+        withKuznyechikPolicy(g, g.getEngineChoice(tunedImito, sizeLarge).engine, [&](const auto& engine) {
+            cmacFinish(engine, kuznyechikKey, state, last, tail, imito, imitoLength);
+        });
+    }
+}
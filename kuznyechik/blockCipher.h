@@ -0,0 +1,60 @@
+#ifndef _BLOCK_CIPHER_H_
+#define _BLOCK_CIPHER_H_
+
+#include "gost12_15.h"
+#include "magma.h"
+#include "blockEngines.h"
+#include "bufferPool.h"
+
+/**
+* \brief  ,   blockCipher.
+*/
+enum cipherAlgorithm {
+    algorithmKuznyechik = 0,
+    algorithmMagma = 1
+};
+
+/**
+* \brief    34.13-2015       .
+*
+*     blockModes.h  ,    : , 
+*         (    setEngineChoice/autotuner),
+*            .
+*           .
+*           .
+*/
+class blockCipher {
+public:
+    blockCipher(cipherAlgorithm algorithm, const uint8_t* key);
+    ~blockCipher();
+
+    blockCipher(const blockCipher&) = delete;
+    blockCipher& operator=(const blockCipher&) = delete;
+
+    cipherAlgorithm getAlgorithm() const;
+    size_t getBlockSize() const;
+
+    void ecbEncrypt(const uint8_t* in, uint8_t* out, size_t blockCount) const;
+    void ecbDecrypt(const uint8_t* in, uint8_t* out, size_t blockCount) const;
+    void ctrCrypt(const uint8_t* sync, uint64_t firstCounter, const uint8_t* in, uint8_t* out, size_t length) const;
+    poolBuffer ctrCrypt(const uint8_t* sync, uint64_t firstCounter, const uint8_t* in, size_t length) const;
+    void cbcEncrypt(uint8_t* iv, const uint8_t* in, uint8_t* out, size_t blockCount) const;
+    void cbcDecrypt(uint8_t* iv, const uint8_t* in, uint8_t* out, size_t blockCount) const;
+    void imito(const uint8_t* data, size_t length, uint8_t* imito, size_t imitoLength) const;
+    void imito(const uint8_t* prefix, const uint8_t* data, size_t length, uint8_t* imito, size_t imitoLength) const;
+    bool imitoVerify(const uint8_t* data, size_t length, const uint8_t* imito, size_t imitoLength) const;
+    void imitoAbsorb(uint8_t* state, const uint8_t* blocks, size_t blockCount) const;
+    void imitoFinish(const uint8_t* state, const uint8_t* last, size_t tail, uint8_t* imito, size_t imitoLength) const;
+private:
+    template <class F>
+    void dispatch(tunedOperation operation, size_t length, F&& f) const;
+
+    cipherAlgorithm algorithm;
+
+    expandedKey kuznyechikKey;
+    kuznyechikDecryptKey kuznyechikInverse;
+    magmaKey magmaForward;
+    magmaKey magmaInverse;
+};
+
+#endif
@@ -0,0 +1,317 @@
+#ifndef _BLOCK_ENGINES_H_
+#define _BLOCK_ENGINES_H_
+
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+#include "gost12_15.h"
+#include "magma.h"
+
+/**
+* \brief  LS : 16    LSTable  64 .
+*
+*    64-  ; table[i]    8 * (i % 8)
+*   i / 8 (. gost12_15::initLSTables).
+*/
+struct tableLS {
+    const uint64_t (*table)[256][2];
+
+    inline void operator()(uint64_t (&block)[2]) const {
+        uint64_t w0 = block[0];
+        uint64_t w1 = block[1];
+        uint64_t t0 = 0;
+        uint64_t t1 = 0;
+
+        for (int i = 0; i < 8; i++) {
+            const uint64_t* e0 = table[i][(w0 >> (8 * i)) & 0xff];
+            const uint64_t* e1 = table[i + 8][(w1 >> (8 * i)) & 0xff];
+            t0 ^= e0[0] ^ e1[0];
+            t1 ^= e0[1] ^ e1[1];
+        }
+
+        block[0] = t0;
+        block[1] = t1;
+    }
+};
+
+/**
+* \brief  LS :   STable  L     8 .
+*
+* table[2 * i]  table[2 * i + 1]   L     
+*    i (    tableLS).
+*/
+struct compactLS {
+    const uint8_t* sbox;
+    const uint64_t (*table)[16][2];
+
+    inline void operator()(uint64_t (&block)[2]) const {
+        uint64_t w0 = block[0];
+        uint64_t w1 = block[1];
+        uint64_t t0 = 0;
+        uint64_t t1 = 0;
+
+        for (int i = 0; i < 8; i++) {
+            uint8_t s0 = sbox[(w0 >> (8 * i)) & 0xff];
+            uint8_t s1 = sbox[(w1 >> (8 * i)) & 0xff];
+            const uint64_t* e0 = table[2 * i][s0 & 0x0f];
+            const uint64_t* f0 = table[2 * i + 1][s0 >> 4];
+            const uint64_t* e1 = table[2 * i + 16][s1 & 0x0f];
+            const uint64_t* f1 = table[2 * i + 17][s1 >> 4];
+            t0 ^= e0[0] ^ f0[0] ^ e1[0] ^ f1[0];
+            t1 ^= e0[1] ^ f0[1] ^ e1[1] ^ f1[1];
+        }
+
+        block[0] = t0;
+        block[1] = t1;
+    }
+};
+
+
+/**
+* \brief   N     .
+*
+*   N   ,       
+*          .
+*/
+template <size_t N, class LS>
+inline void LSXEncryptLanes(const LS& ls, const expandedKey& key, const uint8_t* in, uint8_t* out) {
+    uint64_t state[N][2];
+
+    for (size_t n = 0; n < N; n++) {
+        memcpy(state[n], in + 16 * n, 16);
+    }
+
+    for (int r = 0; r < 9; r++) {
+        uint64_t k[2];
+        memcpy(k, key.roundKeys[r], 16);
+
+        for (size_t n = 0; n < N; n++) {
+            state[n][0] ^= k[0];
+            state[n][1] ^= k[1];
+            ls(state[n]);
+        }
+    }
+
+    uint64_t k[2];
+    memcpy(k, key.roundKeys[9], 16);
+    for (size_t n = 0; n < N; n++) {
+        state[n][0] ^= k[0];
+        state[n][1] ^= k[1];
+        memcpy(out + 16 * n, state[n], 16);
+    }
+}
+
+
+inline void substituteBytes(const uint8_t* sbox, uint64_t (&block)[2]) {
+    uint8_t bytes[16];
+    memcpy(bytes, block, 16);
+    for (int i = 0; i < 16; i++) {
+        bytes[i] = sbox[bytes[i]];
+    }
+    memcpy(block, bytes, 16);
+}
+
+
+/**
+* \brief   N     .
+*
+*   S^-1 L^-1 X[k]   u = L^-1(x):  L^-1 ,
+* u' = L^-1 S^-1(u) xor L^-1(k),      LSInverseTable  .
+* keys[9]  keys[0]    , keys[1..8]    L^-1.
+* ils   L^-1 S^-1: tableLS  LSInverseTable  compactLS  inverseSTable
+*  LInverseNibbleTable.
+*/
+template <size_t N, class ILS>
+inline void LSXDecryptLanes(const ILS& ils, const uint8_t* sbox, const uint8_t* inverseSbox,
+                            const uint64_t (*keys)[2], const uint8_t* in, uint8_t* out) {
+    uint64_t state[N][2];
+
+    for (size_t n = 0; n < N; n++) {
+        memcpy(state[n], in + 16 * n, 16);
+        state[n][0] ^= keys[9][0];
+        state[n][1] ^= keys[9][1];
+        substituteBytes(sbox, state[n]);
+        ils(state[n]);
+    }
+
+    for (int r = 8; r > 0; r--) {
+        for (size_t n = 0; n < N; n++) {
+            ils(state[n]);
+            state[n][0] ^= keys[r][0];
+            state[n][1] ^= keys[r][1];
+        }
+    }
+
+    for (size_t n = 0; n < N; n++) {
+        substituteBytes(inverseSbox, state[n]);
+        state[n][0] ^= keys[0][0];
+        state[n][1] ^= keys[0][1];
+        memcpy(out + 16 * n, state[n], 16);
+    }
+}
+
+/**
+* \brief   : keys[1..8]     L^-1 (. LSXDecryptLanes).
+*/
+struct kuznyechikDecryptKey {
+    alignas(16) uint64_t roundKeys[10][2];
+};
+
+/**
+* \brief    :  ,     .
+*
+*   (block-engine policy)        .
+*   (blockModes.h)       :
+*   keyType, decryptKeyType      ;
+*   blockSize     , macConstant   B   ;
+*   encrypt<N>, decrypt<N>   N    ;
+*   decryptKey    .
+*   gost12_15::initRoundConsts,      .
+*/
+struct kuznyechikEngineBase {
+    typedef expandedKey keyType;
+    typedef kuznyechikDecryptKey decryptKeyType;
+
+    static const size_t blockSize = 16;
+    static const uint8_t macConstant = 0x87;
+
+    explicit kuznyechikEngineBase(const gost12_15& g) : sbox(g.STable.data()), inverseSbox(g.inverseSTable.data()) {}
+
+    const uint8_t* sbox;
+    const uint8_t* inverseSbox;
+};
+
+/**
+* \brief       LS  L^-1 S^-1  .
+*/
+template <class LS>
+struct kuznyechikEngineWith : kuznyechikEngineBase {
+    kuznyechikEngineWith(const gost12_15& g, const LS& ls, const LS& ils) : kuznyechikEngineBase(g), ls(ls), ils(ils) {}
+
+    template <size_t N>
+    inline void encrypt(const expandedKey& key, const uint8_t* in, uint8_t* out) const {
+        LSXEncryptLanes<N>(ls, key, in, out);
+    }
+
+    inline void decryptKey(const expandedKey& key, kuznyechikDecryptKey& inverse) const {
+        memcpy(inverse.roundKeys, key.roundKeys, sizeof(inverse.roundKeys));
+        for (int r = 1; r < 9; r++) {
+            //L^-1(k) = L^-1 S^-1 (S(k))
+            substituteBytes(sbox, inverse.roundKeys[r]);
+            ils(inverse.roundKeys[r]);
+        }
+    }
+
+    template <size_t N>
+    inline void decrypt(const kuznyechikDecryptKey& key, const uint8_t* in, uint8_t* out) const {
+        LSXDecryptLanes<N>(ils, sbox, inverseSbox, key.roundKeys, in, out);
+    }
+
+    LS ls;
+    LS ils;
+};
+
+/**
+* \brief     LSTable  LSInverseTable ( 64 ).
+*/
+struct kuznyechikTableEngine : kuznyechikEngineWith<tableLS> {
+    explicit kuznyechikTableEngine(const gost12_15& g = gost12_15::getInstance())
+        : kuznyechikEngineWith<tableLS>(g, tableLS{ g.LSTable }, tableLS{ g.LSInverseTable }) {}
+};
+
+/**
+* \brief     STable, inverseSTable   
+* LNibbleTable, LInverseNibbleTable ( 8 ).
+*/
+struct kuznyechikCompactEngine : kuznyechikEngineWith<compactLS> {
+    explicit kuznyechikCompactEngine(const gost12_15& g = gost12_15::getInstance())
+        : kuznyechikEngineWith<compactLS>(g, compactLS{ g.STable.data(), g.LNibbleTable },
+                                          compactLS{ g.inverseSTable.data(), g.LInverseNibbleTable }) {}
+};
+
+/**
+* \brief  : 32    g   magma::gTable.
+*
+*          .
+*/
+struct magmaEngine {
+    typedef magmaKey keyType;
+    typedef magmaKey decryptKeyType;
+
+    static const size_t blockSize = 8;
+    static const uint8_t macConstant = 0x1b;
+
+    explicit magmaEngine(const magma& m = magma::getInstance()) : table(m.gTable) {}
+
+    static inline uint32_t load32(const uint8_t* data) {
+        return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16)
+            | (static_cast<uint32_t>(data[2]) << 8) | data[3];
+    }
+
+    static inline void store32(uint8_t* data, uint32_t value) {
+        data[0] = static_cast<uint8_t>(value >> 24);
+        data[1] = static_cast<uint8_t>(value >> 16);
+        data[2] = static_cast<uint8_t>(value >> 8);
+        data[3] = static_cast<uint8_t>(value);
+    }
+
+    inline uint32_t g(uint32_t a, uint32_t k) const {
+        uint32_t x = a + k;
+        return table[0][x & 0xff] ^ table[1][(x >> 8) & 0xff] ^ table[2][(x >> 16) & 0xff] ^ table[3][x >> 24];
+    }
+
+    /**
+    * \brief   N     .
+    *
+    * 32  G[k](a1, a0) = (a0, g[k](a0) xor a1);   G*   ,
+    *      32  G.
+    */
+    template <size_t N>
+    inline void encrypt(const magmaKey& key, const uint8_t* in, uint8_t* out) const {
+        uint32_t a1[N];
+        uint32_t a0[N];
+
+        for (size_t n = 0; n < N; n++) {
+            a1[n] = load32(in + 8 * n);
+            a0[n] = load32(in + 8 * n + 4);
+        }
+
+        for (int r = 0; r < 32; r++) {
+            uint32_t k = key.roundKeys[r];
+            for (size_t n = 0; n < N; n++) {
+                uint32_t t = a1[n] ^ g(a0[n], k);
+                a1[n] = a0[n];
+                a0[n] = t;
+            }
+        }
+
+        for (size_t n = 0; n < N; n++) {
+            store32(out + 8 * n, a0[n]);
+            store32(out + 8 * n + 4, a1[n]);
+        }
+    }
+
+    inline void decryptKey(const magmaKey& key, magmaKey& inverse) const {
+        for (int i = 0; i < 32; i++) {
+            inverse.roundKeys[i] = key.roundKeys[31 - i];
+        }
+    }
+
+    template <size_t N>
+    inline void decrypt(const magmaKey& key, const uint8_t* in, uint8_t* out) const {
+        encrypt<N>(key, in, out);
+    }
+
+    const uint32_t (*table)[256];
+};
+
+// ,    (,      ).
+// GOST12_15_COMPACT_ENGINE      (. withKuznyechikPolicy)
+#ifdef GOST12_15_COMPACT_ENGINE
+typedef kuznyechikCompactEngine kuznyechikEngine;
+#else
+typedef kuznyechikTableEngine kuznyechikEngine;
+#endif
+
+#endif
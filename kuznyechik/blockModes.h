@@ -0,0 +1,500 @@
+#ifndef _BLOCK_MODES_H_
+#define _BLOCK_MODES_H_
+
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+#include "blockEngines.h"
+
+/**
+*    34.13-2015       (. kuznyechikEngineBase).
+*
+*  N   ,   .   N   ,
+*             .
+*  (gostStatistics)    :     gost12_15, magma  blockCipher.
+*/
+
+
+/**
+* \brief     (  ).
+*
+* \param [in] engine   .
+* \param [in] key   .
+* \param [in] in   .
+* \param [out] out    (   in).
+* \param [in] blockCount   .
+*/
+template <size_t N, class Engine>
+inline void ecbEncrypt(const Engine& engine, const typename Engine::keyType& key,
+                       const uint8_t* in, uint8_t* out, size_t blockCount) {
+    const size_t n = Engine::blockSize;
+    size_t i = 0;
+
+    for (; i + N <= blockCount; i += N) {
+        engine.template encrypt<N>(key, in + i * n, out + i * n);
+    }
+
+    for (; i < blockCount; i++) {
+        engine.template encrypt<1>(key, in + i * n, out + i * n);
+    }
+}
+
+
+/**
+* \brief     (  ).
+*
+* \param [in] engine   .
+* \param [in] key    (. Engine::decryptKey).
+* \param [in] in   .
+* \param [out] out    (   in).
+* \param [in] blockCount   .
+*/
+template <size_t N, class Engine>
+inline void ecbDecrypt(const Engine& engine, const typename Engine::decryptKeyType& key,
+                       const uint8_t* in, uint8_t* out, size_t blockCount) {
+    const size_t n = Engine::blockSize;
+    size_t i = 0;
+
+    for (; i + N <= blockCount; i += N) {
+        engine.template decrypt<N>(key, in + i * n, out + i * n);
+    }
+
+    for (; i < blockCount; i++) {
+        engine.template decrypt<1>(key, in + i * n, out + i * n);
+    }
+}
+
+
+/**
+* \brief   ( CTR).
+*
+*     ( )      big-endian
+*     (  2^64    2^32  ).
+*     32 ,    .
+*
+* \param [in] engine   .
+* \param [in] key  .
+* \param [in] sync      .
+* \param [in] firstCounter    .
+* \param [in] in   .
+* \param [out] out    (   in).
+* \param [in] length     .
+*/
+template <size_t N, class Engine>
+inline void ctrCrypt(const Engine& engine, const typename Engine::keyType& key, const uint8_t* sync,
+                     uint64_t firstCounter, const uint8_t* in, uint8_t* out, size_t length) {
+    const size_t n = Engine::blockSize;
+    const size_t chunkBlocks = 32;
+    alignas(16) uint8_t gamma[chunkBlocks * n];
+    uint64_t counter = firstCounter;
+
+    while (length > 0) {
+        size_t blocks = (length + n - 1) / n;
+        if (blocks > chunkBlocks) {
+            blocks = chunkBlocks;
+        }
+
+        for (size_t i = 0; i < blocks; i++) {
+            uint8_t* block = gamma + i * n;
+            memcpy(block, sync, n / 2);
+            for (size_t j = 0; j < n / 2; j++) {
+                block[n - 1 - j] = static_cast<uint8_t>(counter >> (8 * j));
+            }
+            counter++;
+        }
+
+        ecbEncrypt<N>(engine, key, gamma, gamma, blocks);
+
+        size_t chunk = blocks * n < length ? blocks * n : length;
+        for (size_t i = 0; i < chunk; i++) {
+            out[i] = in[i] ^ gamma[i];
+        }
+
+        in += chunk;
+        out += chunk;
+        length -= chunk;
+    }
+}
+
+
+/**
+* \brief         (CBC).
+*
+*  ,     .
+*
+* \param [in] engine   .
+* \param [in] key   .
+* \param [in,out] iv     ;     .
+* \param [in] in   .
+* \param [out] out    (   in).
+* \param [in] blockCount   .
+*/
+template <class Engine>
+inline void cbcEncrypt(const Engine& engine, const typename Engine::keyType& key, uint8_t* iv,
+                       const uint8_t* in, uint8_t* out, size_t blockCount) {
+    const size_t n = Engine::blockSize;
+    uint8_t state[n];
+    memcpy(state, iv, n);
+
+    for (size_t i = 0; i < blockCount; i++) {
+        for (size_t j = 0; j < n; j++) {
+            state[j] ^= in[i * n + j];
+        }
+        engine.template encrypt<1>(key, state, state);
+        memcpy(out + i * n, state, n);
+    }
+
+    memcpy(iv, state, n);
+}
+
+
+/**
+* \brief         (CBC).
+*
+*   ,     N  .
+*         ,   out = in.
+*
+* \param [in] engine   .
+* \param [in] key    (. Engine::decryptKey).
+* \param [in,out] iv     ;     .
+* \param [in] in   .
+* \param [out] out    (   in).
+* \param [in] blockCount   .
+*/
+template <size_t N, class Engine>
+inline void cbcDecrypt(const Engine& engine, const typename Engine::decryptKeyType& key, uint8_t* iv,
+                       const uint8_t* in, uint8_t* out, size_t blockCount) {
+    const size_t n = Engine::blockSize;
+    alignas(16) uint8_t plain[N * n];
+    uint8_t chain[n];
+    uint8_t nextChain[n];
+    memcpy(chain, iv, n);
+
+    size_t i = 0;
+    while (i < blockCount) {
+        size_t group = blockCount - i < N ? 1 : N;
+        const uint8_t* c = in + i * n;
+        uint8_t* p = out + i * n;
+
+        if (group == N) {
+            engine.template decrypt<N>(key, c, plain);
+        }
+        else {
+            engine.template decrypt<1>(key, c, plain);
+        }
+        memcpy(nextChain, c + (group - 1) * n, n);
+
+        for (size_t b = group - 1; b > 0; b--) {
+            for (size_t j = 0; j < n; j++) {
+                p[b * n + j] = plain[b * n + j] ^ c[(b - 1) * n + j];
+            }
+        }
+        for (size_t j = 0; j < n; j++) {
+            p[j] = plain[j] ^ chain[j];
+        }
+
+        memcpy(chain, nextChain, n);
+        i += group;
+    }
+
+    memcpy(iv, chain, n);
+}
+
+
+/**
+* \brief      K1  K2.
+*
+* K1        E(0)     B    ,
+* K2   K1   .
+*
+* \param [in] engine   .
+* \param [in] key  .
+* \param [out] k1   K1   .
+* \param [out] k2   K2   .
+*/
+template <class Engine>
+inline void cmacKeys(const Engine& engine, const typename Engine::keyType& key, uint8_t* k1, uint8_t* k2) {
+    const size_t n = Engine::blockSize;
+    alignas(16) uint8_t r[n] = { 0 };
+    engine.template encrypt<1>(key, r, r);
+
+    const uint8_t* src = r;
+    uint8_t* dst = k1;
+    for (int step = 0; step < 2; step++) {
+        uint8_t carry = src[0] >> 7;
+        for (size_t i = 0; i < n - 1; i++) {
+            dst[i] = static_cast<uint8_t>((src[i] << 1) | (src[i + 1] >> 7));
+        }
+        dst[n - 1] = static_cast<uint8_t>(src[n - 1] << 1);
+        if (carry) {
+            dst[n - 1] ^= Engine::macConstant;
+        }
+
+        src = k1;
+        dst = k2;
+    }
+}
+
+
+/**
+* \brief        (   ).
+*
+*    (  )   cmacFinish,   .
+*
+* \param [in] engine   .
+* \param [in] key  .
+* \param [in,out] state      (   ).
+* \param [in] blocks   .
+* \param [in] blockCount   .
+*/
+template <class Engine>
+inline void cmacAbsorb(const Engine& engine, const typename Engine::keyType& key, uint8_t* state,
+                       const uint8_t* blocks, size_t blockCount) {
+    const size_t n = Engine::blockSize;
+    alignas(16) uint8_t block[n];
+    memcpy(block, state, n);
+
+    for (size_t i = 0; i < blockCount; i++) {
+        for (size_t j = 0; j < n; j++) {
+            block[j] ^= blocks[i * n + j];
+        }
+        engine.template encrypt<1>(key, block, block);
+    }
+
+    memcpy(state, block, n);
+}
+
+
+/**
+* \brief     CMAC: state ^   ^ K1 ()  K2 ().
+*
+* \param [in] state     .
+* \param [in] last    .
+* \param [in] tail     ( 0  n).
+* \param [in] k1    K1.
+* \param [in] k2    K2.
+* \param [out] block      (   state).
+*/
+template <size_t n>
+inline void cmacLastBlock(const uint8_t* state, const uint8_t* last, size_t tail, const uint8_t* k1,
+                          const uint8_t* k2, uint8_t* block) {
+    const uint8_t* lastKey = tail == n ? k1 : k2;
+    for (size_t j = 0; j < n; j++) {
+        uint8_t b = 0;
+        if (j < tail) {
+            b = last[j];
+        }
+        else if (j == tail) {
+            b = 0x80;
+        }
+        block[j] = state[j] ^ b ^ lastKey[j];
+    }
+}
+
+
+/**
+* \brief        .
+*
+*       K1,    1  
+*     K2 (      0).
+*
+* \param [in] engine   .
+* \param [in] key  .
+* \param [in] state    cmacAbsorb.
+* \param [in] last    .
+* \param [in] tail     ( 0   ).
+* \param [out] imito  .
+* \param [in] imitoLength      (   ).
+*/
+template <class Engine>
+inline void cmacFinish(const Engine& engine, const typename Engine::keyType& key, const uint8_t* state,
+                       const uint8_t* last, size_t tail, uint8_t* imito, size_t imitoLength) {
+    const size_t n = Engine::blockSize;
+    uint8_t k1[n];
+    uint8_t k2[n];
+    cmacKeys(engine, key, k1, k2);
+
+    alignas(16) uint8_t block[n];
+    cmacLastBlock<n>(state, last, tail, k1, k2, block);
+    engine.template encrypt<1>(key, block, block);
+
+    memcpy(imito, block, imitoLength < n ? imitoLength : n);
+}
+
+
+/**
+* \brief    N      CMAC.
+*
+*    N     encrypt<N>,   
+*   ;       .
+*   K1  K2   (. cmacKeys).
+*
+* \param [in] engine   .
+* \param [in] key  .
+* \param [in] k1    K1.
+* \param [in] k2    K2.
+* \param [in] messages  N .
+* \param [in] lengths     .
+* \param [out] imitos  N    (N *   ).
+*/
+template <size_t N, class Engine>
+inline void cmacLanes(const Engine& engine, const typename Engine::keyType& key, const uint8_t* k1,
+                      const uint8_t* k2, const uint8_t* const* messages, const size_t* lengths, uint8_t* imitos) {
+    const size_t n = Engine::blockSize;
+    alignas(16) uint8_t state[N * n] = { 0 };
+
+    size_t steps[N];
+    size_t common = 0;
+    for (size_t l = 0; l < N; l++) {
+        steps[l] = lengths[l] == 0 ? 1 : (lengths[l] + n - 1) / n;
+        if (l == 0 || steps[l] < common) {
+            common = steps[l];
+        }
+    }
+
+    for (size_t s = 0; s < common; s++) {
+        for (size_t l = 0; l < N; l++) {
+            const uint8_t* block = messages[l] + s * n;
+            if (s + 1 < steps[l]) {
+                for (size_t j = 0; j < n; j++) {
+                    state[l * n + j] ^= block[j];
+                }
+            }
+            else {
+                cmacLastBlock<n>(state + l * n, block, lengths[l] - s * n, k1, k2, state + l * n);
+            }
+        }
+        engine.template encrypt<N>(key, state, state);
+    }
+
+    for (size_t l = 0; l < N; l++) {
+        if (steps[l] > common) {
+            const uint8_t* rest = messages[l] + common * n;
+            size_t restLength = lengths[l] - common * n;
+            size_t fullBlocks = (restLength - 1) / n;
+            cmacAbsorb(engine, key, state + l * n, rest, fullBlocks);
+            cmacLastBlock<n>(state + l * n, rest + fullBlocks * n, restLength - fullBlocks * n, k1, k2, state + l * n);
+            engine.template encrypt<1>(key, state + l * n, state + l * n);
+        }
+    }
+
+    memcpy(imitos, state, N * n);
+}
+
+
+/**
+* \brief    ( CMAC    34.13-2015)   prefix  .
+*
+*     prefix || data,  prefix    
+* (,  ),   .  prefix = nullptr   data.
+*
+* \param [in] engine   .
+* \param [in] key  .
+* \param [in] prefix      nullptr.
+* \param [in] data  .
+* \param [in] length     .
+* \param [out] imito  .
+* \param [in] imitoLength      (   ).
+*/
+template <class Engine>
+inline void cmacCompute(const Engine& engine, const typename Engine::keyType& key, const uint8_t* prefix,
+                        const uint8_t* data, size_t length, uint8_t* imito, size_t imitoLength) {
+    const size_t n = Engine::blockSize;
+    alignas(16) uint8_t state[n] = { 0 };
+
+    if (prefix && length == 0) {
+        data = prefix;
+        length = n;
+    }
+    else if (prefix) {
+        cmacAbsorb(engine, key, state, prefix, 1);
+    }
+
+    size_t fullBlocks = length == 0 ? 0 : (length - 1) / n;
+    cmacAbsorb(engine, key, state, data, fullBlocks);
+    cmacFinish(engine, key, state, data + fullBlocks * n, length - fullBlocks * n, imito, imitoLength);
+}
+
+
+/**
+* \brief    ( CMAC    34.13-2015).
+*
+* \param [in] engine   .
+* \param [in] key  .
+* \param [in] data  .
+* \param [in] length     .
+* \param [out] imito  .
+* \param [in] imitoLength      (   ).
+*/
+template <class Engine>
+inline void cmacCompute(const Engine& engine, const typename Engine::keyType& key, const uint8_t* data,
+                        size_t length, uint8_t* imito, size_t imitoLength) {
+    cmacCompute(engine, key, nullptr, data, length, imito, imitoLength);
+}
+
+
+/**
+* \brief   f   ,    (1, 2, 4  8 ).
+*
+*    std::integral_constant,        ,
+*    : f(std::integral_constant<size_t, N>()).
+*/
+template <class F>
+inline void withInterleave(int interleave, F&& f) {
+    switch (interleave) {
+    case 1:
+        f(std::integral_constant<size_t, 1>());
+        break;
+    case 2:
+        f(std::integral_constant<size_t, 2>());
+        break;
+    case 8:
+        f(std::integral_constant<size_t, 8>());
+        break;
+    default:
+        f(std::integral_constant<size_t, 4>());
+        break;
+    }
+}
+
+
+/**
+* \brief   f      .
+*
+*  f(engine),  engine  kuznyechikTableEngine  kuznyechikCompactEngine.
+*     GOST12_15_COMPACT_ENGINE,   kuznyechikEngine:
+*      ,   LSTable  LSInverseTable
+*  initRoundConsts  .
+*/
+template <class F>
+inline void withKuznyechikPolicy(const gost12_15& g, blockEngine engine, F&& f) {
+#ifdef GOST12_15_COMPACT_ENGINE
+    (void)engine;
+    f(kuznyechikEngine(g));
+#else
+    if (engine == engineCompact) {
+        f(kuznyechikCompactEngine(g));
+    }
+    else {
+        f(kuznyechikTableEngine(g));
+    }
+#endif
+}
+
+
+/**
+* \brief   f        engineChoice.
+*
+*  f(engine, std::integral_constant<size_t, N>()),  engine  ,
+*  withKuznyechikPolicy.
+*/
+template <class F>
+inline void withKuznyechikEngine(const gost12_15& g, engineChoice choice, F&& f) {
+    withKuznyechikPolicy(g, choice.engine, [&](const auto& engine) {
+        withInterleave(choice.interleave, [&](auto lanes) { f(engine, lanes); });
+    });
+}
+
+#endif
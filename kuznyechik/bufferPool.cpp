@@ -0,0 +1,288 @@
+#include "bufferPool.h"
+
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+
+const size_t bufferPool::alignment;
+const size_t bufferPool::minimumRegion;
+const size_t bufferPool::hugePageSize;
+const int bufferPool::classCount;
+
+
+/**
+* \brief   :     .
+*/
+bufferPool::threadCache::~threadCache() {
+    bufferPool& pool = bufferPool::getInstance();
+    for (int k = 0; k < classCount; k++) {
+        while (lists[k]) {
+            freeRegion* region = lists[k];
+            lists[k] = region->next;
+            pool.releaseRegion(region, minimumRegion << k);
+        }
+    }
+    cachedBytes = 0;
+}
+
+
+/**
+* \brief     .
+*
+* \param [in] region      .
+* \return   k,   minimumRegion * 2^k   region.
+*/
+int bufferPool::sizeClass(size_t region) {
+    int k = 0;
+    while ((minimumRegion << k) < region) {
+        k++;
+    }
+    return k;
+}
+
+
+/**
+* \brief     .
+*
+* \param [in] region   .
+* \return     nullptr.
+*/
+uint8_t* bufferPool::allocateRegion(size_t region) {
+    bool huge = hugePages.load(std::memory_order_relaxed) && region >= hugePageSize;
+    void* memory = nullptr;
+
+#ifdef _WIN32
+    if (huge) {
+        SIZE_T largePage = GetLargePageMinimum();
+        if (largePage != 0 && region % largePage == 0) {
+            memory = VirtualAlloc(nullptr, region, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+        }
+        huge = memory != nullptr;
+    }
+    if (!memory) {
+        memory = VirtualAlloc(nullptr, region, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    }
+#else
+    if (huge) {
+        //  2        
+        size_t mapped = region + hugePageSize;
+        void* raw = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw != MAP_FAILED) {
+            uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+            uintptr_t aligned = (start + hugePageSize - 1) / hugePageSize * hugePageSize;
+            if (aligned > start) {
+                munmap(raw, aligned - start);
+            }
+            if (aligned + region < start + mapped) {
+                munmap(reinterpret_cast<void*>(aligned + region), start + mapped - aligned - region);
+            }
+            memory = reinterpret_cast<void*>(aligned);
+#ifdef MADV_HUGEPAGE
+            madvise(memory, region, MADV_HUGEPAGE);
+#endif
+        }
+        huge = memory != nullptr;
+    }
+    if (!memory) {
+        void* raw = mmap(nullptr, region, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        memory = raw == MAP_FAILED ? nullptr : raw;
+    }
+#endif
+
+    if (!memory) {
+        return nullptr;
+    }
+
+    systemAllocations.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(region, std::memory_order_relaxed);
+    if (huge) {
+        hugePageAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return static_cast<uint8_t*>(memory);
+}
+
+
+void bufferPool::releaseRegion(void* memory, size_t region) {
+    systemReleases.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_sub(region, std::memory_order_relaxed);
+
+#ifdef _WIN32
+    VirtualFree(memory, 0, MEM_RELEASE);
+#else
+    munmap(memory, region);
+#endif
+}
+
+
+/**
+* \brief   .
+*
+*      2^k   ,    size.
+*     ,     .
+*
+* \param [in] size     .
+* \param [out] capacity    ,     release.
+* \return  ,   ;     std::bad_alloc.
+*/
+uint8_t* bufferPool::acquire(size_t size, size_t& capacity) {
+    acquisitions.fetch_add(1, std::memory_order_relaxed);
+
+    int k = sizeClass(size);
+    size_t region = minimumRegion << k;
+    threadCache& cache = local();
+
+    uint8_t* buffer = nullptr;
+    if (k < classCount && cache.lists[k]) {
+        freeRegion* cached = cache.lists[k];
+        cache.lists[k] = cached->next;
+        cache.cachedBytes -= region;
+        cached->next = nullptr;
+        buffer = reinterpret_cast<uint8_t*>(cached);
+        reuses.fetch_add(1, std::memory_order_relaxed);
+    }
+    else {
+        buffer = allocateRegion(region);
+        if (!buffer) {
+            throw std::bad_alloc();
+        }
+    }
+
+    capacity = region;
+    return buffer;
+}
+
+
+/**
+* \brief       .
+*
+*    .    ,   .
+*
+* \param [in] buffer  ,  acquire (  nullptr).
+* \param [in] capacity   ,  acquire.
+* \param [in] usedLength    ,   .
+*/
+void bufferPool::release(uint8_t* buffer, size_t capacity, size_t usedLength) {
+    if (!buffer) {
+        return;
+    }
+
+    size_t region = capacity;
+    memset(buffer, 0, usedLength < region ? usedLength : region);
+
+    threadCache& cache = local();
+    int k = sizeClass(region);
+    if (k >= classCount || cache.cachedBytes + region > threadCacheLimit.load(std::memory_order_relaxed)) {
+        releaseRegion(buffer, region);
+        return;
+    }
+
+    freeRegion* cached = reinterpret_cast<freeRegion*>(buffer);
+    cached->next = cache.lists[k];
+    cache.lists[k] = cached;
+    cache.cachedBytes += region;
+}
+
+
+/**
+* \brief         .
+*/
+void bufferPool::trim() {
+    threadCache& cache = local();
+    for (int k = 0; k < classCount; k++) {
+        while (cache.lists[k]) {
+            freeRegion* region = cache.lists[k];
+            cache.lists[k] = region->next;
+            releaseRegion(region, minimumRegion << k);
+        }
+    }
+    cache.cachedBytes = 0;
+}
+
+
+/**
+* \brief         2 .
+*
+* \param [in] enabled  true,    .
+*/
+void bufferPool::setHugePages(bool enabled) {
+    hugePages = enabled;
+}
+
+
+/**
+* \brief       .
+*
+* \param [in] bytes    .
+*/
+void bufferPool::setThreadCacheLimit(size_t bytes) {
+    threadCacheLimit = bytes;
+}
+
+
+/**
+* \brief    .
+*
+* \return   .
+*/
+bufferPoolStatistics bufferPool::statistics() {
+    bufferPoolStatistics s;
+    s.acquisitions = acquisitions.load(std::memory_order_relaxed);
+    s.reuses = reuses.load(std::memory_order_relaxed);
+    s.systemAllocations = systemAllocations.load(std::memory_order_relaxed);
+    s.systemReleases = systemReleases.load(std::memory_order_relaxed);
+    s.hugePageAllocations = hugePageAllocations.load(std::memory_order_relaxed);
+    s.allocatedBytes = allocatedBytes.load(std::memory_order_relaxed);
+    return s;
+}
+
+
+poolBuffer::poolBuffer(size_t size) : length(size) {
+    buffer = bufferPool::getInstance().acquire(size, bufferCapacity);
+}
+
+
+poolBuffer::poolBuffer(poolBuffer&& other) : buffer(other.buffer), length(other.length), bufferCapacity(other.bufferCapacity) {
+    other.buffer = nullptr;
+    other.length = 0;
+    other.bufferCapacity = 0;
+}
+
+
+poolBuffer& poolBuffer::operator=(poolBuffer&& other) {
+    if (this != &other) {
+        reset();
+        buffer = other.buffer;
+        length = other.length;
+        bufferCapacity = other.bufferCapacity;
+        other.buffer = nullptr;
+        other.length = 0;
+        other.bufferCapacity = 0;
+    }
+    return *this;
+}
+
+
+poolBuffer::~poolBuffer() {
+    reset();
+}
+
+
+/**
+* \brief        .
+*/
+void poolBuffer::reset() {
+    bufferPool::getInstance().release(buffer, bufferCapacity, length);
+    buffer = nullptr;
+    length = 0;
+    bufferCapacity = 0;
+}
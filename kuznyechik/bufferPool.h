@@ -0,0 +1,125 @@
+#ifndef _BUFFER_POOL_H_
+#define _BUFFER_POOL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+/**
+* \brief     (  ).
+*/
+struct bufferPoolStatistics {
+    uint64_t acquisitions;
+    uint64_t reuses;
+    uint64_t systemAllocations;
+    uint64_t systemReleases;
+    uint64_t hugePageAllocations;
+    uint64_t allocatedBytes;
+};
+
+/**
+* \brief      .
+*
+*     2^k  (  4 ),     (mmap/VirtualAlloc)
+*    ;      ,    2^k 
+*   2^k .     ,  acquire,   
+*  .         .
+*      ,   ,   
+*        page fault.
+*    ,       .
+*     (setThreadCacheLimit),       trim.
+*     (setHugePages)   2    2   
+*    (madvise(MADV_HUGEPAGE)  MEM_LARGE_PAGES,    ).
+*/
+class bufferPool {
+public:
+    static bufferPool& getInstance() {
+        static bufferPool p;
+        return p;
+    }
+
+    uint8_t* acquire(size_t size, size_t& capacity);
+    void release(uint8_t* buffer, size_t capacity, size_t usedLength);
+    void trim();
+
+    void setHugePages(bool enabled);
+    void setThreadCacheLimit(size_t bytes);
+    bufferPoolStatistics statistics();
+
+    static const size_t alignment = 64;
+    static const size_t minimumRegion = 4096;
+    static const size_t hugePageSize = 2 * 1024 * 1024;
+    static const int classCount = 36;
+private:
+    struct freeRegion {
+        freeRegion* next;
+    };
+
+    struct threadCache {
+        freeRegion* lists[classCount] = {};
+        size_t cachedBytes = 0;
+        ~threadCache();
+    };
+
+    bufferPool() {}
+    ~bufferPool() {}
+
+    bufferPool(const bufferPool&) = delete;
+    bufferPool& operator=(const bufferPool&) = delete;
+
+    static threadCache& local() {
+        static thread_local threadCache cache;
+        return cache;
+    }
+
+    static int sizeClass(size_t region);
+    uint8_t* allocateRegion(size_t region);
+    void releaseRegion(void* memory, size_t region);
+
+    std::atomic<bool> hugePages{ false };
+    std::atomic<size_t> threadCacheLimit{ 256 * 1024 * 1024 };
+
+    std::atomic<uint64_t> acquisitions{ 0 };
+    std::atomic<uint64_t> reuses{ 0 };
+    std::atomic<uint64_t> systemAllocations{ 0 };
+    std::atomic<uint64_t> systemReleases{ 0 };
+    std::atomic<uint64_t> hugePageAllocations{ 0 };
+    std::atomic<uint64_t> allocatedBytes{ 0 };
+};
+
+/**
+* \brief    bufferPool    .
+*
+*        .
+*/
+class poolBuffer {
+public:
+    poolBuffer() : buffer(nullptr), length(0), bufferCapacity(0) {}
+    explicit poolBuffer(size_t size);
+    poolBuffer(poolBuffer&& other);
+    poolBuffer& operator=(poolBuffer&& other);
+    ~poolBuffer();
+
+    poolBuffer(const poolBuffer&) = delete;
+    poolBuffer& operator=(const poolBuffer&) = delete;
+
+    uint8_t* data() const {
+        return buffer;
+    }
+
+    size_t size() const {
+        return length;
+    }
+
+    size_t capacity() const {
+        return bufferCapacity;
+    }
+
+    void reset();
+private:
+    uint8_t* buffer;
+    size_t length;
+    size_t bufferCapacity;
+};
+
+#endif
@@ -0,0 +1,232 @@
+#include "cmacKdf.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "blockModes.h"
+#include "gostStatistics.h"
+
+
+namespace {
+
+void store32(uint8_t* data, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        data[i] = static_cast<uint8_t>(value >> (24 - 8 * i));
+    }
+}
+
+}
+
+
+/**
+* \brief :  -     K1, K2.
+*
+*      initRoundConsts.
+*
+* \param [in] algorithm  ,    .
+* \param [in] masterKey  - (32 ).
+*/
+cmacKdf::cmacKdf(cipherAlgorithm algorithm, const uint8_t* masterKey) : algorithm(algorithm) {
+    memset(&kuznyechikKey, 0, sizeof(kuznyechikKey));
+    memset(&magmaForward, 0, sizeof(magmaForward));
+    memset(k1, 0, sizeof(k1));
+    memset(k2, 0, sizeof(k2));
+
+    if (algorithm == algorithmMagma) {
+        magma &m = magma::getInstance();
+        m.expandKey(masterKey, magmaForward);
+        cmacKeys(magmaEngine(m), magmaForward, k1, k2);
+    }
+    else {
+        gost12_15 &g = gost12_15::getInstance();
+        g.expandKey(masterKey, kuznyechikKey);
+        withKuznyechikPolicy(g, g.getEngineChoice(tunedImito, sizeSmall).engine, [&](const auto& engine) {
+            cmacKeys(engine, kuznyechikKey, k1, k2);
+        });
+    }
+}
+
+
+/**
+* \brief :   -   .
+*/
+cmacKdf::~cmacKdf() {
+    volatile uint8_t* p = reinterpret_cast<volatile uint8_t*>(&kuznyechikKey);
+    for (size_t i = 0; i < sizeof(kuznyechikKey); i++) {
+        p[i] = 0;
+    }
+    p = reinterpret_cast<volatile uint8_t*>(&magmaForward);
+    for (size_t i = 0; i < sizeof(magmaForward); i++) {
+        p[i] = 0;
+    }
+    p = k1;
+    for (size_t i = 0; i < sizeof(k1); i++) {
+        p[i] = 0;
+    }
+    p = k2;
+    for (size_t i = 0; i < sizeof(k2); i++) {
+        p[i] = 0;
+    }
+}
+
+
+cipherAlgorithm cmacKdf::getAlgorithm() const {
+    return algorithm;
+}
+
+
+size_t cmacKdf::getBlockSize() const {
+    return algorithm == algorithmMagma ? magmaEngine::blockSize : kuznyechikEngineBase::blockSize;
+}
+
+
+/**
+* \brief       .
+*
+*  f(engine, key, std::integral_constant<size_t, N>()).   
+* ,   ,       .
+*
+* \param [in] f   .
+*/
+template <class F>
+void cmacKdf::dispatch(F&& f) const {
+    gost12_15 &g = gost12_15::getInstance();
+    engineChoice choice = g.getEngineChoice(tunedGamma, sizeLarge);
+
+    if (algorithm == algorithmMagma) {
+        magmaEngine engine;
+        withInterleave(choice.interleave, [&](auto lanes) { f(engine, magmaForward, lanes); });
+    }
+    else {
+        withKuznyechikEngine(g, choice, [&](const auto& engine, auto lanes) { f(engine, kuznyechikKey, lanes); });
+    }
+}
+
+
+/**
+* \brief    PRF: BE32(i) || label || 0x00 || context || BE32(8 * keyLength).
+*
+* \param [in] request  .
+* \param [in] counter      i ( 1).
+* \param [out] message   PRF.
+* \return     .
+*/
+size_t cmacKdf::buildInput(const kdfRequest& request, uint32_t counter, uint8_t* message) const {
+    store32(message, counter);
+    size_t offset = 4;
+    if (request.labelLength > 0) {
+        memcpy(message + offset, request.label, request.labelLength);
+        offset += request.labelLength;
+    }
+    message[offset++] = 0x00;
+    if (request.contextLength > 0) {
+        memcpy(message + offset, request.context, request.contextLength);
+        offset += request.contextLength;
+    }
+    store32(message + offset, static_cast<uint32_t>(request.keyLength * 8));
+    return offset + 4;
+}
+
+
+/**
+* \brief     .
+*
+* \param [in] label   ( ).
+* \param [in] labelLength     .
+* \param [in] context   (,    ).
+* \param [in] contextLength     .
+* \param [out] key   .
+* \param [in] keyLength      (  maxKeyLength).
+* \return  false,        BE32(8 * keyLength).
+*/
+bool cmacKdf::derive(const uint8_t* label, size_t labelLength, const uint8_t* context, size_t contextLength,
+                     uint8_t* key, size_t keyLength) const {
+    kdfRequest request = { label, labelLength, context, contextLength, key, keyLength };
+    return deriveBatch(&request, 1);
+}
+
+
+/**
+* \brief       .
+*
+*   PRF (     )     
+*   N  CMAC   (cmacLanes);     2   1.
+*
+* \param [in] requests   (    key).
+* \param [in] count   .
+* \return  false (  ),   -   maxKeyLength.
+*/
+bool cmacKdf::deriveBatch(const kdfRequest* requests, size_t count) const {
+    const size_t blockSize = getBlockSize();
+
+    size_t inputCount = 0;
+    size_t maxInput = 0;
+    for (size_t r = 0; r < count; r++) {
+        if (requests[r].keyLength > maxKeyLength) {
+            return false;
+        }
+        inputCount += (requests[r].keyLength + blockSize - 1) / blockSize;
+        maxInput = std::max(maxInput, 4 + requests[r].labelLength + 1 + requests[r].contextLength + 4);
+    }
+
+    std::vector<prfInput> inputs;
+    inputs.reserve(inputCount);
+    uint64_t inputBytes = 0;
+    for (size_t r = 0; r < count; r++) {
+        size_t length = 4 + requests[r].labelLength + 1 + requests[r].contextLength + 4;
+        uint32_t blocks = static_cast<uint32_t>((requests[r].keyLength + blockSize - 1) / blockSize);
+        for (uint32_t i = 1; i <= blocks; i++) {
+            inputs.push_back({ r, i, length });
+        }
+        inputBytes += static_cast<uint64_t>(length) * blocks;
+    }
+    std::sort(inputs.begin(), inputs.end(), [](const prfInput& a, const prfInput& b) { return a.length < b.length; });
+
+    GOST_STAT_ADD(counterImitoBytes, inputBytes);
+    GOST_STAT_TIMER(operationImito);
+
+    dispatch([&](const auto& engine, const auto& key, auto lanes) {
+        const size_t N = decltype(lanes)::value;
+        poolBuffer messages(N * maxInput);
+
+        auto run = [&](auto width, size_t first) {
+            const size_t M = decltype(width)::value;
+            const uint8_t* pointers[M];
+            size_t lengths[M];
+            alignas(16) uint8_t imitos[M * 16];
+
+            for (size_t l = 0; l < M; l++) {
+                const prfInput& input = inputs[first + l];
+                pointers[l] = messages.data() + l * maxInput;
+                lengths[l] = buildInput(requests[input.request], input.counter, messages.data() + l * maxInput);
+            }
+            cmacLanes<M>(engine, key, k1, k2, pointers, lengths, imitos);
+
+            for (size_t l = 0; l < M; l++) {
+                const prfInput& input = inputs[first + l];
+                size_t offset = static_cast<size_t>(input.counter - 1) * blockSize;
+                size_t part = std::min(blockSize, requests[input.request].keyLength - offset);
+                memcpy(requests[input.request].key + offset, imitos + l * blockSize, part);
+            }
+
+            volatile uint8_t* p = imitos;
+            for (size_t i = 0; i < sizeof(imitos); i++) {
+                p[i] = 0;
+            }
+        };
+
+        size_t i = 0;
+        for (; i + N <= inputs.size(); i += N) {
+            run(lanes, i);
+        }
+        for (; N > 2 && i + 2 <= inputs.size(); i += 2) {
+            run(std::integral_constant<size_t, 2>(), i);
+        }
+        for (; i < inputs.size(); i++) {
+            run(std::integral_constant<size_t, 1>(), i);
+        }
+    });
+
+    return true;
+}
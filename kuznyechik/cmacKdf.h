@@ -0,0 +1,63 @@
+#ifndef _CMAC_KDF_H_
+#define _CMAC_KDF_H_
+
+#include "blockCipher.h"
+
+/**
+* \brief      .
+*/
+struct kdfRequest {
+    const uint8_t* label;
+    size_t labelLength;
+    const uint8_t* context;
+    size_t contextLength;
+    uint8_t* key;
+    size_t keyLength;
+};
+
+/**
+* \brief       (NIST SP 800-108,  ).
+*
+* key = K(1) || K(2) || ... (  keyLength), 
+* K(i) = MAC(BE32(i) || label || 0x00 || context || BE32(8 * keyLength)).
+* - ,    K1  K2     .
+* deriveBatch     ,    CMAC
+*   (    , . getEngineChoice).
+*           .
+*/
+class cmacKdf {
+public:
+    cmacKdf(cipherAlgorithm algorithm, const uint8_t* masterKey);
+    ~cmacKdf();
+
+    cmacKdf(const cmacKdf&) = delete;
+    cmacKdf& operator=(const cmacKdf&) = delete;
+
+    cipherAlgorithm getAlgorithm() const;
+    size_t getBlockSize() const;
+
+    bool derive(const uint8_t* label, size_t labelLength, const uint8_t* context, size_t contextLength,
+                uint8_t* key, size_t keyLength) const;
+    bool deriveBatch(const kdfRequest* requests, size_t count) const;
+
+    static const size_t maxKeyLength = 0x1fffffff;
+private:
+    struct prfInput {
+        size_t request;
+        uint32_t counter;
+        size_t length;
+    };
+
+    template <class F>
+    void dispatch(F&& f) const;
+    size_t buildInput(const kdfRequest& request, uint32_t counter, uint8_t* message) const;
+
+    cipherAlgorithm algorithm;
+
+    expandedKey kuznyechikKey;
+    magmaKey magmaForward;
+    uint8_t k1[16];
+    uint8_t k2[16];
+};
+
+#endif
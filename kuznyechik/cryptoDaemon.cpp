@@ -0,0 +1,846 @@
+#include "cryptoDaemon.h"
+
+#include <cstring>
+#include <algorithm>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <afunix.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+
+namespace {
+
+const size_t requestHeaderSize = 20;
+const size_t responseHeaderSize = 8;
+const uint32_t maxRequestLength = 64 * 1024 * 1024;
+const int keySize = 32;
+const int syncSize = 8;
+const int blockSize = 16;
+const int imitoLen = 8;
+
+#ifdef _WIN32
+const intptr_t invalidSocket = static_cast<intptr_t>(INVALID_SOCKET);
+const int sendFlags = 0;
+
+bool socketStartup() {
+    WSADATA wsaData;
+    return WSAStartup(MAKEWORD(2, 2), &wsaData) == 0;
+}
+
+void closeSocket(intptr_t s) {
+    closesocket(static_cast<SOCKET>(s));
+}
+
+void shutdownSocket(intptr_t s) {
+    shutdown(static_cast<SOCKET>(s), SD_BOTH);
+}
+
+void removeSocketFile(const string& path) {
+    DeleteFileA(path.c_str());
+}
+
+//  Windows     ACL ,    .
+bool restrictSocketFile(const string&) {
+    return true;
+}
+
+bool peerAllowed(intptr_t) {
+    return true;
+}
+#else
+const intptr_t invalidSocket = -1;
+#ifdef MSG_NOSIGNAL
+const int sendFlags = MSG_NOSIGNAL;
+#else
+const int sendFlags = 0;
+#endif
+
+bool socketStartup() {
+    return true;
+}
+
+void closeSocket(intptr_t s) {
+    ::close(static_cast<int>(s));
+}
+
+void shutdownSocket(intptr_t s) {
+    shutdown(static_cast<int>(s), SHUT_RDWR);
+}
+
+void removeSocketFile(const string& path) {
+    unlink(path.c_str());
+}
+
+bool restrictSocketFile(const string& path) {
+    return chmod(path.c_str(), S_IRUSR | S_IWUSR) == 0;
+}
+
+/**
+* \brief  ,      ,   .
+*
+* \param [in] connection   .
+* \return  false,         .
+*/
+bool peerAllowed(intptr_t connection) {
+#ifdef SO_PEERCRED
+    ucred credentials;
+    socklen_t length = sizeof(credentials);
+    if (getsockopt(static_cast<int>(connection), SOL_SOCKET, SO_PEERCRED, &credentials, &length) != 0) {
+        return false;
+    }
+    return credentials.uid == geteuid();
+#else
+    uid_t uid;
+    gid_t gid;
+    if (getpeereid(static_cast<int>(connection), &uid, &gid) != 0) {
+        return false;
+    }
+    return uid == geteuid();
+#endif
+}
+#endif
+
+
+/**
+* \brief    .
+*/
+void wipeKey(expandedKey& key) {
+    volatile uint8_t* p = &key.roundKeys[0][0];
+    for (size_t i = 0; i < sizeof(expandedKey); i++) {
+        p[i] = 0;
+    }
+}
+
+
+/**
+* \brief    Unix domain socket.
+*
+* \param [in] path     .
+* \param [out] address   .
+* \return  false,      .
+*/
+bool makeAddress(const string& path, sockaddr_un& address) {
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    memcpy(address.sun_path, path.c_str(), path.size());
+    return true;
+}
+
+
+bool sendAll(intptr_t s, const uint8_t* data, size_t length) {
+    while (length > 0) {
+        int chunk = length > (1 << 20) ? (1 << 20) : static_cast<int>(length);
+        int sent = static_cast<int>(send(s, reinterpret_cast<const char*>(data), chunk, sendFlags));
+        if (sent <= 0) {
+            return false;
+        }
+        data += sent;
+        length -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+
+bool receiveAll(intptr_t s, uint8_t* data, size_t length) {
+    while (length > 0) {
+        int chunk = length > (1 << 20) ? (1 << 20) : static_cast<int>(length);
+        int received = static_cast<int>(recv(s, reinterpret_cast<char*>(data), chunk, 0));
+        if (received <= 0) {
+            return false;
+        }
+        data += received;
+        length -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+
+void putUint32(uint8_t* p, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+
+uint32_t getUint32(const uint8_t* p) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        value |= static_cast<uint32_t>(p[i]) << (8 * i);
+    }
+    return value;
+}
+
+
+void putUint64(uint8_t* p, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        p[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+
+uint64_t getUint64(const uint8_t* p) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value |= static_cast<uint64_t>(p[i]) << (8 * i);
+    }
+    return value;
+}
+
+
+vector<uint8_t> serializeStatistics(const daemonStatistics& stats) {
+    const uint64_t fields[] = {
+        stats.requests, stats.batches, stats.blocks, stats.bytes,
+        stats.maxBatchRequests, stats.totalLatencyNs, stats.maxLatencyNs, stats.uptimeNs
+    };
+    vector<uint8_t> result(sizeof(fields), 0);
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+        putUint64(result.data() + 8 * i, fields[i]);
+    }
+    return result;
+}
+
+
+daemonStatistics deserializeStatistics(const vector<uint8_t>& data) {
+    daemonStatistics stats = {};
+    uint64_t* fields[] = {
+        &stats.requests, &stats.batches, &stats.blocks, &stats.bytes,
+        &stats.maxBatchRequests, &stats.totalLatencyNs, &stats.maxLatencyNs, &stats.uptimeNs
+    };
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]) && 8 * i + 8 <= data.size(); i++) {
+        *fields[i] = getUint64(data.data() + 8 * i);
+    }
+    return stats;
+}
+
+}
+
+
+/**
+* \brief   .
+*
+*   ,   .    
+*   initRoundConsts   .
+*
+* \param [in] maxBatchRequests       .
+* \param [in] batchWindowUs       ,  .
+*/
+cryptoDaemon::cryptoDaemon(size_t maxBatchRequests, unsigned batchWindowUs)
+    : maxBatchRequests(maxBatchRequests), batchWindow(batchWindowUs) {
+    started = std::chrono::steady_clock::now();
+    worker = std::thread(&cryptoDaemon::workerLoop, this);
+}
+
+
+cryptoDaemon::~cryptoDaemon() {
+    stop();
+}
+
+
+/**
+* \brief     .
+*
+*         expandedKey   unloadKey.
+*
+* \param [in] key    32 .
+* \return    (0    ).
+*/
+uint32_t cryptoDaemon::loadKey(const vector<uint8_t>& key) {
+    return loadKeyFor(key, 0);
+}
+
+
+/**
+* \brief      .
+*
+* \param [in] key    32 .
+* \param [in] owner  : 0    ,   .
+* \return    (0       ).
+*/
+uint32_t cryptoDaemon::loadKeyFor(const vector<uint8_t>& key, uint64_t owner) {
+    if (key.size() != keySize) {
+        return 0;
+    }
+
+    loadedKey loaded;
+    gost12_15::getInstance().expandKey(key.data(), loaded.key);
+    loaded.owner = owner;
+
+    std::lock_guard<std::mutex> lock(keysMutex);
+    if (keys.size() >= UINT32_MAX - 1) {
+        wipeKey(loaded.key);
+        return 0;
+    }
+
+    // 0  ,      
+    uint32_t keyId = nextKeyId++;
+    while (keyId == 0 || keys.count(keyId) != 0) {
+        keyId = nextKeyId++;
+    }
+    keys[keyId] = loaded;
+
+    wipeKey(loaded.key);
+    return keyId;
+}
+
+
+/**
+* \brief         .
+*
+* \param [in] keyId   .
+* \return  false,    .
+*/
+bool cryptoDaemon::unloadKey(uint32_t keyId) {
+    return unloadKeyFor(keyId, 0);
+}
+
+
+/**
+* \brief      .
+*
+* \param [in] keyId   .
+* \param [in] owner  ,  .
+* \return  false,        .
+*/
+bool cryptoDaemon::unloadKeyFor(uint32_t keyId, uint64_t owner) {
+    std::lock_guard<std::mutex> lock(keysMutex);
+    auto it = keys.find(keyId);
+    if (it == keys.end() || it->second.owner != owner) {
+        return false;
+    }
+
+    wipeKey(it->second.key);
+    keys.erase(it);
+    return true;
+}
+
+
+/**
+* \brief      (  ).
+*
+* \param [in] owner  .
+*/
+void cryptoDaemon::unloadOwnedKeys(uint64_t owner) {
+    std::lock_guard<std::mutex> lock(keysMutex);
+    for (auto it = keys.begin(); it != keys.end();) {
+        if (it->second.owner == owner) {
+            wipeKey(it->second.key);
+            it = keys.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+
+/**
+* \brief       .
+*
+*             .
+*       .
+*
+* \param [in] operation  daemonGamma  daemonImito.
+* \param [in] keyId   .
+* \param [in] sync    8  (  daemonGamma).
+* \param [in] data  .
+* \param [out] result     .
+* \return  false   ,     .
+*/
+bool cryptoDaemon::submit(daemonOperation operation, uint32_t keyId, const vector<uint8_t>& sync,
+                          const vector<uint8_t>& data, vector<uint8_t>& result) {
+    return submitFor(operation, keyId, 0, sync, data, result);
+}
+
+
+/**
+* \brief       .
+*
+* \param [in] operation  daemonGamma  daemonImito.
+* \param [in] keyId   .
+* \param [in] owner  ;     .
+* \param [in] sync    8  (  daemonGamma).
+* \param [in] data  .
+* \param [out] result     .
+* \return  false   ,     .
+*/
+bool cryptoDaemon::submitFor(daemonOperation operation, uint32_t keyId, uint64_t owner, const vector<uint8_t>& sync,
+                             const vector<uint8_t>& data, vector<uint8_t>& result) {
+    if (operation != daemonGamma && operation != daemonImito) {
+        return false;
+    }
+
+    request r;
+    r.operation = operation;
+    r.keyId = keyId;
+    r.owner = owner;
+    r.sync = &sync;
+    r.data = &data;
+    r.result = &result;
+    r.status = false;
+    r.done = false;
+    r.enqueued = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(queueMutex);
+    if (stopping) {
+        return false;
+    }
+    queue.push_back(&r);
+    queueCondition.notify_one();
+    doneCondition.wait(lock, [&r] { return r.done; });
+
+    return r.status;
+}
+
+
+/**
+* \brief    .
+*
+*   ,       batchWindow
+*         processBatch.
+*/
+void cryptoDaemon::workerLoop() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+
+    while (true) {
+        queueCondition.wait(lock, [this] { return stopping || !queue.empty(); });
+        if (queue.empty()) {
+            break;
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + batchWindow;
+        while (!stopping && queue.size() < maxBatchRequests) {
+            if (queueCondition.wait_until(lock, deadline) == std::cv_status::timeout) {
+                break;
+            }
+        }
+
+        vector<request*> batch;
+        while (!queue.empty() && batch.size() < maxBatchRequests) {
+            batch.push_back(queue.front());
+            queue.pop_front();
+        }
+
+        lock.unlock();
+        processBatch(batch);
+        lock.lock();
+
+        for (size_t i = 0; i < batch.size(); i++) {
+            batch[i]->done = true;
+        }
+        doneCondition.notify_all();
+    }
+}
+
+
+/**
+* \brief    .
+*
+*     ,      
+* gammaCryptionBatch,        .
+*      1,   gammaCryption.
+*       .
+*
+* \param [in] batch   .
+*/
+void cryptoDaemon::processBatch(vector<request*>& batch) {
+    gost12_15& g = gost12_15::getInstance();
+
+    map<uint32_t, expandedKey> batchKeys;
+    {
+        std::lock_guard<std::mutex> lock(keysMutex);
+        for (size_t i = 0; i < batch.size(); i++) {
+            auto it = keys.find(batch[i]->keyId);
+            if (it != keys.end() && it->second.owner == batch[i]->owner) {
+                batchKeys[it->first] = it->second.key;
+            }
+        }
+    }
+
+    map<uint32_t, vector<request*>> gammaGroups;
+    uint64_t blocks = 0;
+    uint64_t bytes = 0;
+
+    for (size_t i = 0; i < batch.size(); i++) {
+        request* r = batch[i];
+        auto key = batchKeys.find(r->keyId);
+        if (key == batchKeys.end()) {
+            continue;
+        }
+
+        bytes += r->data->size();
+        if (r->operation == daemonGamma) {
+            if (r->sync->size() == syncSize) {
+                gammaGroups[r->keyId].push_back(r);
+            }
+        }
+        else {
+            //     ,   ,     
+            uint8_t imito[blockSize];
+            g.imitoGenerationBlocks(key->second, r->data->data(), r->data->size(), imito, imitoLen);
+            r->result->assign(imito, imito + imitoLen);
+            blocks += r->data->size() / blockSize + 1;
+            r->status = true;
+        }
+    }
+
+    vector<packetDescriptor> packets;
+    for (auto group = gammaGroups.begin(); group != gammaGroups.end(); ++group) {
+        vector<request*>& requests = group->second;
+
+        packets.clear();
+        for (size_t i = 0; i < requests.size(); i++) {
+            *requests[i]->result = *requests[i]->data;
+            packetDescriptor packet = { requests[i]->sync->data(), requests[i]->result->data(), requests[i]->result->size() };
+            packets.push_back(packet);
+            blocks += (packet.length + blockSize - 1) / blockSize;
+        }
+
+        g.gammaCryptionBatch(batchKeys[group->first], packets.data(), packets.size());
+
+        for (size_t i = 0; i < requests.size(); i++) {
+            requests[i]->status = true;
+        }
+    }
+
+    for (auto key = batchKeys.begin(); key != batchKeys.end(); ++key) {
+        wipeKey(key->second);
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(statisticsMutex);
+    stats.requests += batch.size();
+    stats.batches++;
+    stats.blocks += blocks;
+    stats.bytes += bytes;
+    stats.maxBatchRequests = std::max<uint64_t>(stats.maxBatchRequests, batch.size());
+    for (size_t i = 0; i < batch.size(); i++) {
+        uint64_t latency = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - batch[i]->enqueued).count());
+        stats.totalLatencyNs += latency;
+        stats.maxLatencyNs = std::max(stats.maxLatencyNs, latency);
+    }
+}
+
+
+/**
+* \brief     .
+*
+* \return   , , ,   .
+*/
+daemonStatistics cryptoDaemon::statistics() {
+    std::lock_guard<std::mutex> lock(statisticsMutex);
+    daemonStatistics snapshot = stats;
+    snapshot.uptimeNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - started).count());
+    return snapshot;
+}
+
+
+/**
+* \brief      Unix domain socket.
+*
+*  :  (1 ), 3  ,   (4 ),
+*  (8 ),   (4 ), .  :   (1 ),
+* 3  ,   (4 ), .     little-endian.
+*     ,    
+*    .      (0600,  
+*  listen),         .
+*
+* \param [in] socketPath      (  ).
+* \return  false,     .
+*/
+bool cryptoDaemon::listen(const string& socketPath) {
+    sockaddr_un address;
+    if (listenSocket != invalidSocket || !makeAddress(socketPath, address) || !socketStartup()) {
+        return false;
+    }
+
+    removeSocketFile(socketPath);
+    intptr_t s = static_cast<intptr_t>(socket(AF_UNIX, SOCK_STREAM, 0));
+    if (s == invalidSocket) {
+        return false;
+    }
+
+    if (bind(s, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        closeSocket(s);
+        return false;
+    }
+    if (!restrictSocketFile(socketPath) || ::listen(s, 64) != 0) {
+        closeSocket(s);
+        removeSocketFile(socketPath);
+        return false;
+    }
+
+    this->socketPath = socketPath;
+    listenSocket = s;
+    acceptThread = std::thread(&cryptoDaemon::acceptLoop, this);
+    return true;
+}
+
+
+void cryptoDaemon::acceptLoop() {
+    while (true) {
+        intptr_t connection = static_cast<intptr_t>(accept(listenSocket, nullptr, nullptr));
+        if (connection == invalidSocket) {
+            break;
+        }
+        if (!peerAllowed(connection)) {
+            closeSocket(connection);
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        for (size_t i = 0; i < connectionThreads.size();) {
+            auto finished = std::find(finishedThreads.begin(), finishedThreads.end(), connectionThreads[i].get_id());
+            if (finished != finishedThreads.end()) {
+                finishedThreads.erase(finished);
+                connectionThreads[i].join();
+                connectionThreads.erase(connectionThreads.begin() + i);
+            }
+            else {
+                i++;
+            }
+        }
+
+        connections.push_back(connection);
+        connectionThreads.push_back(std::thread(&cryptoDaemon::connectionLoop, this, connection, nextConnectionId++));
+    }
+}
+
+
+/**
+* \brief    .
+*
+* ,   ,        .
+*
+* \param [in] connection   .
+* \param [in] owner    (  ).
+*/
+void cryptoDaemon::connectionLoop(intptr_t connection, uint64_t owner) {
+    uint8_t header[requestHeaderSize];
+    vector<uint8_t> sync(syncSize, 0);
+    vector<uint8_t> data;
+    vector<uint8_t> result;
+
+    while (receiveAll(connection, header, requestHeaderSize)) {
+        daemonOperation operation = static_cast<daemonOperation>(header[0]);
+        uint32_t keyId = getUint32(header + 4);
+        memcpy(sync.data(), header + 8, syncSize);
+        uint32_t length = getUint32(header + 16);
+        if (length > maxRequestLength) {
+            break;
+        }
+
+        data.resize(length);
+        if (!receiveAll(connection, data.data(), length)) {
+            break;
+        }
+
+        bool status = false;
+        result.clear();
+        switch (operation) {
+        case daemonLoadKey:
+            keyId = loadKeyFor(data, owner);
+            status = keyId != 0;
+            result.assign(4, 0);
+            putUint32(result.data(), keyId);
+            break;
+        case daemonUnloadKey:
+            status = unloadKeyFor(keyId, owner);
+            break;
+        case daemonGamma:
+        case daemonImito:
+            status = submitFor(operation, keyId, owner, sync, data, result);
+            break;
+        case daemonStatisticsRequest:
+            result = serializeStatistics(statistics());
+            status = true;
+            break;
+        }
+
+        if (!status) {
+            result.clear();
+        }
+
+        uint8_t response[responseHeaderSize] = { 0 };
+        response[0] = status ? 1 : 0;
+        putUint32(response + 4, static_cast<uint32_t>(result.size()));
+        if (!sendAll(connection, response, responseHeaderSize) ||
+            !sendAll(connection, result.data(), result.size())) {
+            break;
+        }
+    }
+
+    unloadOwnedKeys(owner);
+
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+    auto it = std::find(connections.begin(), connections.end(), connection);
+    if (it != connections.end()) {
+        connections.erase(it);
+        closeSocket(connection);
+    }
+    finishedThreads.push_back(std::this_thread::get_id());
+}
+
+
+/**
+* \brief   .
+*
+*  ,       ,
+*    .
+*/
+void cryptoDaemon::stop() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCondition.notify_all();
+
+    if (listenSocket != invalidSocket) {
+        shutdownSocket(listenSocket);
+        closeSocket(listenSocket);
+        acceptThread.join();
+        listenSocket = invalidSocket;
+        removeSocketFile(socketPath);
+    }
+
+    vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        for (size_t i = 0; i < connections.size(); i++) {
+            shutdownSocket(connections[i]);
+        }
+        threads.swap(connectionThreads);
+        finishedThreads.clear();
+    }
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+
+cryptoDaemonClient::~cryptoDaemonClient() {
+    close();
+}
+
+
+/**
+* \brief     .
+*
+* \param [in] socketPath      .
+* \return  false,    .
+*/
+bool cryptoDaemonClient::connect(const string& socketPath) {
+    sockaddr_un address;
+    if (!makeAddress(socketPath, address) || !socketStartup()) {
+        return false;
+    }
+
+    close();
+    intptr_t s = static_cast<intptr_t>(socket(AF_UNIX, SOCK_STREAM, 0));
+    if (s == invalidSocket) {
+        return false;
+    }
+
+    if (::connect(s, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        closeSocket(s);
+        return false;
+    }
+
+    connection = s;
+    return true;
+}
+
+
+void cryptoDaemonClient::close() {
+    if (connection != invalidSocket) {
+        closeSocket(connection);
+        connection = invalidSocket;
+    }
+}
+
+
+bool cryptoDaemonClient::call(daemonOperation operation, uint32_t keyId, const vector<uint8_t>& sync,
+                              const vector<uint8_t>& data, vector<uint8_t>& result) {
+    if (connection == invalidSocket || data.size() > maxRequestLength) {
+        return false;
+    }
+
+    uint8_t header[requestHeaderSize] = { 0 };
+    header[0] = operation;
+    putUint32(header + 4, keyId);
+    if (!sync.empty()) {
+        memcpy(header + 8, sync.data(), std::min<size_t>(sync.size(), syncSize));
+    }
+    putUint32(header + 16, static_cast<uint32_t>(data.size()));
+
+    uint8_t response[responseHeaderSize];
+    if (!sendAll(connection, header, requestHeaderSize) || !sendAll(connection, data.data(), data.size()) ||
+        !receiveAll(connection, response, responseHeaderSize)) {
+        return false;
+    }
+
+    result.resize(getUint32(response + 4));
+    if (!receiveAll(connection, result.data(), result.size())) {
+        return false;
+    }
+
+    return response[0] == 1;
+}
+
+
+bool cryptoDaemonClient::loadKey(const vector<uint8_t>& key, uint32_t& keyId) {
+    vector<uint8_t> result;
+    if (!call(daemonLoadKey, 0, vector<uint8_t>(), key, result) || result.size() != 4) {
+        return false;
+    }
+    keyId = getUint32(result.data());
+    return true;
+}
+
+
+bool cryptoDaemonClient::unloadKey(uint32_t keyId) {
+    vector<uint8_t> result;
+    return call(daemonUnloadKey, keyId, vector<uint8_t>(), vector<uint8_t>(), result);
+}
+
+
+bool cryptoDaemonClient::gammaCryption(uint32_t keyId, const vector<uint8_t>& sync, const vector<uint8_t>& data,
+                                       vector<uint8_t>& result) {
+    if (sync.size() != syncSize) {
+        return false;
+    }
+    return call(daemonGamma, keyId, sync, data, result);
+}
+
+
+bool cryptoDaemonClient::imitoGeneration(uint32_t keyId, const vector<uint8_t>& data, vector<uint8_t>& imito) {
+    return call(daemonImito, keyId, vector<uint8_t>(), data, imito);
+}
+
+
+bool cryptoDaemonClient::statistics(daemonStatistics& stats) {
+    vector<uint8_t> result;
+    if (!call(daemonStatisticsRequest, 0, vector<uint8_t>(), vector<uint8_t>(), result)) {
+        return false;
+    }
+    stats = deserializeStatistics(result);
+    return true;
+}
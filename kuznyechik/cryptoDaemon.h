@@ -0,0 +1,147 @@
+#ifndef _CRYPTO_DAEMON_H_
+#define _CRYPTO_DAEMON_H_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <atomic>
+
+#include "gost12_15.h"
+
+using std::string;
+
+/**
+* \brief    .
+*/
+enum daemonOperation : uint8_t {
+    daemonLoadKey = 1,
+    daemonUnloadKey = 2,
+    daemonGamma = 3,
+    daemonImito = 4,
+    daemonStatisticsRequest = 5
+};
+
+/**
+* \brief      .
+*/
+struct daemonStatistics {
+    uint64_t requests;
+    uint64_t batches;
+    uint64_t blocks;
+    uint64_t bytes;
+    uint64_t maxBatchRequests;
+    uint64_t totalLatencyNs;
+    uint64_t maxLatencyNs;
+    uint64_t uptimeNs;
+};
+
+/**
+* \brief  ,         .
+*
+*      submit,   Unix domain socket (listen).
+* ,   ,  ,   :  
+*      ,      .
+*       maxBatchRequests ,    batchWindow
+*  ,          encryptBlocks.
+*/
+class cryptoDaemon {
+public:
+    cryptoDaemon(size_t maxBatchRequests = 64, unsigned batchWindowUs = 50);
+    ~cryptoDaemon();
+
+    uint32_t loadKey(const vector<uint8_t>& key);
+    bool unloadKey(uint32_t keyId);
+
+    bool submit(daemonOperation operation, uint32_t keyId, const vector<uint8_t>& sync,
+                const vector<uint8_t>& data, vector<uint8_t>& result);
+
+    bool listen(const string& socketPath);
+    void stop();
+
+    daemonStatistics statistics();
+private:
+    struct request {
+        daemonOperation operation;
+        uint32_t keyId;
+        uint64_t owner;
+        const vector<uint8_t>* sync;
+        const vector<uint8_t>* data;
+        vector<uint8_t>* result;
+        bool status;
+        bool done;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    struct loadedKey {
+        expandedKey key;
+        uint64_t owner;
+    };
+
+    uint32_t loadKeyFor(const vector<uint8_t>& key, uint64_t owner);
+    bool unloadKeyFor(uint32_t keyId, uint64_t owner);
+    void unloadOwnedKeys(uint64_t owner);
+    bool submitFor(daemonOperation operation, uint32_t keyId, uint64_t owner, const vector<uint8_t>& sync,
+                   const vector<uint8_t>& data, vector<uint8_t>& result);
+
+    void workerLoop();
+    void processBatch(vector<request*>& batch);
+    void acceptLoop();
+    void connectionLoop(intptr_t connection, uint64_t owner);
+
+    size_t maxBatchRequests;
+    std::chrono::microseconds batchWindow;
+
+    std::mutex keysMutex;
+    map<uint32_t, loadedKey> keys;
+    uint32_t nextKeyId = 1;
+
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    std::condition_variable doneCondition;
+    std::deque<request*> queue;
+    bool stopping = false;
+    std::thread worker;
+
+    intptr_t listenSocket = -1;
+    string socketPath;
+    std::thread acceptThread;
+    std::mutex connectionsMutex;
+    vector<intptr_t> connections;
+    uint64_t nextConnectionId = 1;
+    vector<std::thread> connectionThreads;
+    vector<std::thread::id> finishedThreads;
+
+    std::mutex statisticsMutex;
+    daemonStatistics stats = {};
+    std::chrono::steady_clock::time_point started;
+};
+
+/**
+* \brief       Unix domain socket.
+*/
+class cryptoDaemonClient {
+public:
+    cryptoDaemonClient() {}
+    ~cryptoDaemonClient();
+
+    bool connect(const string& socketPath);
+    void close();
+
+    bool loadKey(const vector<uint8_t>& key, uint32_t& keyId);
+    bool unloadKey(uint32_t keyId);
+    bool gammaCryption(uint32_t keyId, const vector<uint8_t>& sync, const vector<uint8_t>& data, vector<uint8_t>& result);
+    bool imitoGeneration(uint32_t keyId, const vector<uint8_t>& data, vector<uint8_t>& imito);
+    bool statistics(daemonStatistics& stats);
+private:
+    bool call(daemonOperation operation, uint32_t keyId, const vector<uint8_t>& sync,
+              const vector<uint8_t>& data, vector<uint8_t>& result);
+
+    intptr_t connection = -1;
+};
+
+#endif
@@ -0,0 +1,489 @@
+#include "ctrDrbg.h"
+
+#include <cstring>
+#include <random>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <mutex>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+
+namespace {
+
+const size_t blockSize = 16;
+
+
+void secureZero(void* data, size_t length) {
+    volatile uint8_t* p = static_cast<volatile uint8_t*>(data);
+    for (size_t i = 0; i < length; i++) {
+        p[i] = 0;
+    }
+}
+
+
+uint64_t loadCounter(const uint8_t* data) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value = (value << 8) | data[i];
+    }
+    return value;
+}
+
+
+void storeCounter(uint8_t* data, uint64_t value) {
+    for (int i = 7; i >= 0; i--) {
+        data[i] = static_cast<uint8_t>(value);
+        value >>= 8;
+    }
+}
+
+
+/**
+* \brief   128-   1 (  ).
+*/
+void incrementCounter(uint8_t* counter) {
+    for (int i = 15; i >= 0; i--) {
+        if (++counter[i] != 0) {
+            break;
+        }
+    }
+}
+
+
+/**
+* \brief     ,  initRoundConsts   .
+*/
+void initCipher() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        gost12_15 &g = gost12_15::getInstance();
+        if (!g.isInitialized()) {
+            g.initRoundConsts();
+        }
+    });
+}
+
+
+/**
+* \brief     (  fork).
+*/
+int64_t processId() {
+#ifdef _WIN32
+    return _getpid();
+#else
+    return getpid();
+#endif
+}
+
+
+/**
+* \brief      seedlen (   ).
+*/
+void padSeed(const uint8_t* data, size_t length, uint8_t* seed) {
+    memset(seed, 0, ctrDrbg::seedLength);
+    if (data) {
+        memcpy(seed, data, std::min(length, ctrDrbg::seedLength));
+    }
+}
+
+}
+
+
+const size_t ctrDrbg::seedLength;
+const size_t ctrDrbg::maxRequestLength;
+const uint64_t ctrDrbg::reseedInterval;
+
+
+/**
+* \brief    .
+*
+* \param [in] source    (  systemEntropy).
+* \param [in] personalization    (  nullptr).
+* \param [in] personalizationLength    ,   48 .
+*/
+ctrDrbg::ctrDrbg(const entropySource& source, const uint8_t* personalization, size_t personalizationLength)
+    : source(source ? source : entropySource(&ctrDrbg::systemEntropy)) {
+    instantiate(personalization, personalizationLength);
+}
+
+
+ctrDrbg::~ctrDrbg() {
+    secureZero(key, sizeof(key));
+    secureZero(counter, sizeof(counter));
+    secureZero(&expanded, sizeof(expanded));
+}
+
+
+/**
+* \brief     (std::random_device).
+*
+* \param [out] data  .
+* \param [in] length   .
+* \return  false,   .
+*/
+bool ctrDrbg::systemEntropy(uint8_t* data, size_t length) {
+    try {
+        std::random_device random;
+        for (size_t i = 0; i < length; i += 4) {
+            uint32_t value = random();
+            memcpy(data + i, &value, std::min<size_t>(4, length - i));
+        }
+    }
+    catch (...) {
+        return false;
+    }
+    return true;
+}
+
+
+/**
+* \brief    CTR_DRBG_Update.
+*
+* (K, V)    48   E(K, V + 1) || E(K, V + 2) || E(K, V + 3),   provided.
+*
+* \param [in] provided    seedLength .
+*/
+void ctrDrbg::update(const uint8_t* provided) {
+    uint8_t temp[seedLength];
+    keystream(temp, seedLength / blockSize);
+
+    for (size_t i = 0; i < seedLength; i++) {
+        temp[i] ^= provided[i];
+    }
+
+    memcpy(key, temp, sizeof(key));
+    memcpy(counter, temp + sizeof(key), sizeof(counter));
+    gost12_15::getInstance().expandKey(key, expanded);
+    secureZero(temp, sizeof(temp));
+}
+
+
+/**
+* \brief   blockCount   E(K, V + 1), E(K, V + 2), ...   V.
+*
+*  8  V  ,      gammaCryptionBlocks.
+*         .
+*
+* \param [out] out    blockCount * 16 .
+* \param [in] blockCount   .
+*/
+void ctrDrbg::keystream(uint8_t* out, size_t blockCount) {
+    gost12_15 &g = gost12_15::getInstance();
+
+    while (blockCount > 0) {
+        uint64_t low = loadCounter(counter + 8);
+
+        if (low == UINT64_MAX) {
+            incrementCounter(counter);
+            g.encryptBlocks(expanded, counter, out, 1);
+            out += blockSize;
+            blockCount--;
+            continue;
+        }
+
+        size_t blocks = static_cast<size_t>(std::min<uint64_t>(blockCount, UINT64_MAX - low));
+        memset(out, 0, blocks * blockSize);
+        g.gammaCryptionBlocks(expanded, counter, low + 1, out, out, blocks * blockSize);
+        storeCounter(counter + 8, low + blocks);
+
+        out += blocks * blockSize;
+        blockCount -= blocks;
+    }
+}
+
+
+/**
+* \brief   (CTR_DRBG_Instantiate    ).
+*
+*      ,  initRoundConsts ().
+*
+* \param [in] personalization    (  nullptr).
+* \param [in] personalizationLength    .
+* \return  false,      .
+*/
+bool ctrDrbg::instantiate(const uint8_t* personalization, size_t personalizationLength) {
+    uint8_t seed[seedLength];
+    uint8_t entropy[seedLength];
+
+    instantiated = false;
+    if (!source(entropy, seedLength)) {
+        return false;
+    }
+
+    padSeed(personalization, personalizationLength, seed);
+    for (size_t i = 0; i < seedLength; i++) {
+        seed[i] ^= entropy[i];
+    }
+
+    initCipher();
+    memset(key, 0, sizeof(key));
+    memset(counter, 0, sizeof(counter));
+    gost12_15::getInstance().expandKey(key, expanded);
+    update(seed);
+
+    reseedCounter = 1;
+    instantiated = true;
+    secureZero(seed, sizeof(seed));
+    secureZero(entropy, sizeof(entropy));
+    return true;
+}
+
+
+/**
+* \brief      (CTR_DRBG_Reseed).
+*
+* \param [in] additional    (  nullptr).
+* \param [in] additionalLength    ,   48 .
+* \return  false,          .
+*/
+bool ctrDrbg::reseed(const uint8_t* additional, size_t additionalLength) {
+    uint8_t seed[seedLength];
+    uint8_t entropy[seedLength];
+
+    if (!instantiated || !source(entropy, seedLength)) {
+        return false;
+    }
+
+    padSeed(additional, additionalLength, seed);
+    for (size_t i = 0; i < seedLength; i++) {
+        seed[i] ^= entropy[i];
+    }
+
+    update(seed);
+    reseedCounter = 1;
+    secureZero(seed, sizeof(seed));
+    secureZero(entropy, sizeof(entropy));
+    return true;
+}
+
+
+/**
+* \brief        maxRequestLength (CTR_DRBG_Generate).
+*/
+bool ctrDrbg::generateRequest(uint8_t* out, size_t length, const uint8_t* additional, size_t additionalLength,
+                              bool predictionResistance) {
+    uint8_t seed[seedLength];
+
+    if (predictionResistance || reseedCounter > reseedInterval) {
+        if (!reseed(additional, additionalLength)) {
+            return false;
+        }
+        additional = nullptr;
+        additionalLength = 0;
+    }
+
+    padSeed(additional, additionalLength, seed);
+    if (additional && additionalLength > 0) {
+        update(seed);
+    }
+
+    size_t blocks = length / blockSize;
+    keystream(out, blocks);
+    if (length % blockSize != 0) {
+        uint8_t last[blockSize];
+        keystream(last, 1);
+        memcpy(out + blocks * blockSize, last, length % blockSize);
+        secureZero(last, sizeof(last));
+    }
+
+    update(seed);
+    reseedCounter++;
+    secureZero(seed, sizeof(seed));
+    return true;
+}
+
+
+/**
+* \brief    .
+*
+*   maxRequestLength    ,
+*            .
+*
+* \param [out] out  .
+* \param [in] length   .
+* \param [in] additional    (  nullptr).
+* \param [in] additionalLength    ,   48 .
+* \param [in] predictionResistance       .
+* \return  false,         .
+*/
+bool ctrDrbg::generate(uint8_t* out, size_t length, const uint8_t* additional, size_t additionalLength,
+                       bool predictionResistance) {
+    if (!instantiated) {
+        return false;
+    }
+
+    bool resist = predictionResistance || this->predictionResistance;
+    do {
+        size_t request = std::min(length, maxRequestLength);
+        if (!generateRequest(out, request, additional, additionalLength, resist)) {
+            return false;
+        }
+
+        additional = nullptr;
+        additionalLength = 0;
+        resist = this->predictionResistance;
+        out += request;
+        length -= request;
+    } while (length > 0);
+
+    return true;
+}
+
+
+/**
+* \brief        .
+*
+* \param [in] enabled     .
+*/
+void ctrDrbg::setPredictionResistance(bool enabled) {
+    predictionResistance = enabled;
+}
+
+
+bool ctrDrbg::isInstantiated() const {
+    return instantiated;
+}
+
+
+uint64_t ctrDrbg::getReseedCounter() const {
+    return reseedCounter;
+}
+
+
+struct threadRandom::threadState {
+    ctrDrbg* drbg;
+    uint8_t buffer[bufferSize];
+    size_t position;
+    int64_t owner;
+
+    threadState() : position(bufferSize), owner(processId()) {
+        uint8_t personalization[32] = { 0 };
+        size_t id = std::hash<std::thread::id>()(std::this_thread::get_id());
+        int64_t now = std::chrono::steady_clock::now().time_since_epoch().count();
+        const void* address = this;
+        memcpy(personalization, &id, sizeof(id));
+        memcpy(personalization + 8, &now, sizeof(now));
+        memcpy(personalization + 16, &address, sizeof(address));
+
+        drbg = new ctrDrbg(entropySource(), personalization, sizeof(personalization));
+    }
+
+    ~threadState() {
+        secureZero(buffer, sizeof(buffer));
+        delete drbg;
+    }
+};
+
+
+threadRandom::threadState& threadRandom::local() {
+    static thread_local threadState state;
+    return state;
+}
+
+
+/**
+* \brief  ,    fork   .
+*
+*          ,  
+* ,      .
+*
+* \param [in,out] state   .
+* \return  false,     .
+*/
+bool threadRandom::checkProcess(threadState& state) {
+    int64_t current = processId();
+    if (state.owner == current) {
+        return true;
+    }
+
+    secureZero(state.buffer, sizeof(state.buffer));
+    state.position = bufferSize;
+    uint8_t additional[sizeof(current)];
+    memcpy(additional, &current, sizeof(current));
+    if (!state.drbg->reseed(additional, sizeof(additional))) {
+        return false;
+    }
+    state.owner = current;
+    return true;
+}
+
+
+/**
+* \brief        .
+*
+*     .       .
+*
+* \param [out] out  .
+* \param [in] length   .
+* \return  false,        
+*    fork.
+*/
+bool threadRandom::bytes(uint8_t* out, size_t length) {
+    threadState& state = local();
+    if (!checkProcess(state)) {
+        return false;
+    }
+
+    if (length >= bufferSize) {
+        return state.drbg->generate(out, length);
+    }
+
+    while (length > 0) {
+        if (state.position == bufferSize) {
+            if (!state.drbg->generate(state.buffer, bufferSize)) {
+                return false;
+            }
+            state.position = 0;
+        }
+
+        size_t chunk = std::min(length, bufferSize - state.position);
+        memcpy(out, state.buffer + state.position, chunk);
+        secureZero(state.buffer + state.position, chunk);
+        state.position += chunk;
+        out += chunk;
+        length -= chunk;
+    }
+
+    return true;
+}
+
+
+/**
+* \brief     .
+*
+* \param [out] out  ,  .
+* \return  false,     .
+*/
+bool threadRandom::bytes(vector<uint8_t>& out) {
+    return out.empty() || bytes(out.data(), out.size());
+}
+
+
+/**
+* \brief    64- .
+*/
+uint64_t threadRandom::next64() {
+    uint64_t value = 0;
+    bytes(reinterpret_cast<uint8_t*>(&value), sizeof(value));
+    return value;
+}
+
+
+/**
+* \brief         .
+*
+* \return  false,      .
+*/
+bool threadRandom::reseed() {
+    threadState& state = local();
+    secureZero(state.buffer, sizeof(state.buffer));
+    state.position = bufferSize;
+    state.owner = processId();
+    return state.drbg->reseed();
+}
@@ -0,0 +1,85 @@
+#ifndef _CTR_DRBG_H_
+#define _CTR_DRBG_H_
+
+#include <functional>
+
+#include "gost12_15.h"
+
+/**
+* \brief  :   length  ,  false  .
+*/
+typedef std::function<bool(uint8_t* data, size_t length)> entropySource;
+
+/**
+* \brief     CTR_DRBG (NIST SP 800-90A)   gost12_15.
+*
+*    K (32 )   V (16 ), seedlen = 48 ,  
+*  (derivation function)  ,     
+*  .     gammaCryptionBlocks.
+*   ,     threadRandom.
+*      (initRoundConsts  ,  
+*   ).  fork     ; 
+*  (reseed)      .
+*/
+class ctrDrbg {
+public:
+    static const size_t seedLength = 48;
+    static const size_t maxRequestLength = 64 * 1024;
+    static const uint64_t reseedInterval = 1ULL << 32;
+
+    explicit ctrDrbg(const entropySource& source = entropySource(), const uint8_t* personalization = nullptr,
+                     size_t personalizationLength = 0);
+    ~ctrDrbg();
+
+    ctrDrbg(const ctrDrbg&) = delete;
+    ctrDrbg& operator=(const ctrDrbg&) = delete;
+
+    bool instantiate(const uint8_t* personalization, size_t personalizationLength);
+    bool reseed(const uint8_t* additional = nullptr, size_t additionalLength = 0);
+    bool generate(uint8_t* out, size_t length, const uint8_t* additional = nullptr, size_t additionalLength = 0,
+                  bool predictionResistance = false);
+
+    void setPredictionResistance(bool enabled);
+    bool isInstantiated() const;
+    uint64_t getReseedCounter() const;
+
+    static bool systemEntropy(uint8_t* data, size_t length);
+private:
+    void update(const uint8_t* provided);
+    void keystream(uint8_t* out, size_t blockCount);
+    bool generateRequest(uint8_t* out, size_t length, const uint8_t* additional, size_t additionalLength,
+                         bool predictionResistance);
+
+    entropySource source;
+    uint8_t key[32];
+    uint8_t counter[16];
+    expandedKey expanded;
+    uint64_t reseedCounter = 0;
+    bool instantiated = false;
+    bool predictionResistance = false;
+};
+
+/**
+* \brief    :     ctrDrbg    .
+*
+*       ,  
+*   generate.      
+*     .     fork  
+* ,      ,  
+*       .
+*/
+class threadRandom {
+public:
+    static bool bytes(uint8_t* out, size_t length);
+    static bool bytes(vector<uint8_t>& out);
+    static uint64_t next64();
+    static bool reseed();
+private:
+    static const size_t bufferSize = 4096;
+
+    struct threadState;
+    static threadState& local();
+    static bool checkProcess(threadState& state);
+};
+
+#endif
@@ -1,5 +1,10 @@
 #include "gost12_15.h"
 
+#include <cstring>
+
+#include "gostStatistics.h"
+#include "blockModes.h"
+
 
 /**
 * \brief         .
@@ -226,6 +231,87 @@ void gost12_15::initRoundConsts() {
         this->roundConsts[i] = inverseData(this->roundConsts[i]);
         this->roundConsts[i] = LTransformation(this->roundConsts[i]);
         this->roundConsts[i] = inverseData(this->roundConsts[i]);
+        memcpy(this->roundConstsWords[i], this->roundConsts[i].data(), blockSize);
+    }
+
+    initLSTables();
+    initialized.store(true, std::memory_order_release);
+}
+
+
+/**
+* \brief  ,      (  initRoundConsts).
+*/
+bool gost12_15::isInitialized() const {
+    return initialized.load(std::memory_order_acquire);
+}
+
+
+/**
+* \brief     LS .
+*
+*  L   GF(2),   LS        2
+*      .    16     256  
+*  LS  ,    ,    LSTable.
+*        16      xor.
+*       ,     64- ,
+*   big-endian      .
+*     LSInverseTable  L^-1 S^-1.
+*        LNibbleTable  LInverseNibbleTable:  L
+*  L^-1       (S  S^-1      
+* ).
+*    initRoundConsts.
+*/
+void gost12_15::initLSTables() {
+    uint64_t probe = 1;
+    bool littleEndian = *reinterpret_cast<uint8_t*>(&probe) == 1;
+
+    for (int i = 0; i < blockSize; i++) {
+        int slot = littleEndian ? i : (i / 8) * 8 + 7 - i % 8;
+
+        for (int b = 0; b < 256; b++) {
+            vector<uint8_t> unit(blockSize, 0);
+            unit[i] = STable[b];
+
+            unit = inverseData(unit);
+            unit = LTransformation(unit);
+            unit = inverseData(unit);
+
+            memcpy(LSTable[slot][b], unit.data(), blockSize);
+        }
+
+        for (int n = 0; n < 16; n++) {
+            for (int half = 0; half < 2; half++) {
+                vector<uint8_t> unit(blockSize, 0);
+                unit[i] = static_cast<uint8_t>(n << (4 * half));
+
+                unit = inverseData(unit);
+                unit = LTransformation(unit);
+                unit = inverseData(unit);
+
+                memcpy(LNibbleTable[2 * slot + half][n], unit.data(), blockSize);
+
+                unit.assign(blockSize, 0);
+                unit[i] = static_cast<uint8_t>(n << (4 * half));
+
+                unit = inverseData(unit);
+                unit = inverseLTransformation(unit);
+                unit = inverseData(unit);
+
+                memcpy(LInverseNibbleTable[2 * slot + half][n], unit.data(), blockSize);
+            }
+        }
+
+        for (int b = 0; b < 256; b++) {
+            vector<uint8_t> unit(blockSize, 0);
+            unit[i] = inverseSTable[b];
+
+            unit = inverseData(unit);
+            unit = inverseLTransformation(unit);
+            unit = inverseData(unit);
+
+            memcpy(LSInverseTable[slot][b], unit.data(), blockSize);
+        }
     }
 }
 
@@ -247,6 +333,9 @@ void gost12_15::initRoundConsts() {
 * \return      10 ( )  16 ( ).
 */
 vector<vector<uint8_t>> gost12_15::generatingRoundKeys(vector<uint8_t> key) {
+    GOST_STAT_ADD(counterKeyExpansions, 1);
+    GOST_STAT_TIMER(operationKeyExpansion);
+
     vector<vector<uint8_t>> roundKeys;
     roundKeys.resize(10);
     for (size_t i = 0; i < roundKeys.size(); i++) {
@@ -303,6 +392,8 @@ vector<vector<uint8_t>> gost12_15::generatingRoundKeys(vector<uint8_t> key) {
 * \return    LSX   .
 */
 vector<uint8_t> gost12_15::LSXEncryptData(vector<uint8_t> data, vector<vector<uint8_t>> roundKeys) {
+    GOST_STAT_ADD(counterBlocksEncrypted, 1);
+
     vector<uint8_t> encData = data;
 
     for (int i = 0; i < 9; i++) {
@@ -327,6 +418,8 @@ vector<uint8_t> gost12_15::LSXEncryptData(vector<uint8_t> data, vector<vector<ui
 * \return    LSX    .
 */
 vector<uint8_t> gost12_15::LSXDecryptData(vector<uint8_t> data, vector<vector<uint8_t>> roundKeys) {
+    GOST_STAT_ADD(counterBlocksDecrypted, 1);
+
     vector<uint8_t> decData = data;
 
     for (int i = 9; i > 0; i--) {
@@ -487,6 +580,9 @@ vector<uint8_t> gost12_15::inverseData(vector<uint8_t> data) {
 * \return     -  ()  .
 */
 vector<uint8_t> gost12_15::gammaCryption(vector<uint8_t> data, vector<uint8_t> sync, vector<vector<uint8_t>> roundKeys) {
+    GOST_STAT_ADD(counterGammaBytes, data.size());
+    GOST_STAT_TIMER(operationGamma);
+
     vector<uint8_t> gammaSync(blockSize, 0);
     for (int i = 0; i < blockSize / 2; i++) {
         gammaSync[i] = sync[i];
@@ -524,6 +620,9 @@ vector<uint8_t> gost12_15::gammaCryption(vector<uint8_t> data, vector<uint8_t> s
 * \return   .
 */
 vector<uint8_t> gost12_15::imitoGeneration(vector<uint8_t> data, vector<vector<uint8_t>> roundKeys) {
+    GOST_STAT_ADD(counterImitoBytes, data.size());
+    GOST_STAT_TIMER(operationImito);
+
     vector<uint8_t> imito(imitoLen, 0);
     vector<uint8_t> blockData(blockSize, 0);
     int blockCount = static_cast<int>(data.size() / blockSize);
@@ -590,4 +689,414 @@ vector<uint8_t> gost12_15::getImitoKey(vector<vector<uint8_t>> roundKeys) {
     }
 
     return imitoKey;
-}
\ No newline at end of file
+}
+
+/**
+* \brief        .
+*
+* \param [in] roundKeys -   ,   generatingRoundKeys.
+* \return       .
+*/
+expandedKey gost12_15::packRoundKeys(const vector<vector<uint8_t>>& roundKeys) {
+    expandedKey key;
+
+    for (int i = 0; i < 10; i++) {
+        memcpy(key.roundKeys[i], roundKeys[i].data(), blockSize);
+    }
+
+    return key;
+}
+
+
+namespace {
+
+template <class LS>
+void expandKeyWith(const LS& ls, const uint64_t (*roundConsts)[2], const uint8_t* key, expandedKey& expanded) {
+    uint64_t k1[2];
+    uint64_t k2[2];
+    memcpy(k1, key, 16);
+    memcpy(k2, key + 16, 16);
+
+    memcpy(expanded.roundKeys[0], k1, 16);
+    memcpy(expanded.roundKeys[1], k2, 16);
+
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 8; j += 2) {
+            uint64_t lsx[2] = { k1[0] ^ roundConsts[8 * i + j][0], k1[1] ^ roundConsts[8 * i + j][1] };
+            ls(lsx);
+            k2[0] ^= lsx[0];
+            k2[1] ^= lsx[1];
+
+            lsx[0] = k2[0] ^ roundConsts[8 * i + j + 1][0];
+            lsx[1] = k2[1] ^ roundConsts[8 * i + j + 1][1];
+            ls(lsx);
+            k1[0] ^= lsx[0];
+            k1[1] ^= lsx[1];
+        }
+        memcpy(expanded.roundKeys[i * 2 + 2], k1, 16);
+        memcpy(expanded.roundKeys[i * 2 + 3], k2, 16);
+    }
+
+    volatile uint64_t* p = k1;
+    p[0] = 0;
+    p[1] = 0;
+    p = k2;
+    p[0] = 0;
+    p[1] = 0;
+}
+
+}
+
+
+/**
+* \brief          .
+*
+* engineTable   LSTable  LSInverseTable ( 64   ), engineCompact 
+*  STable, inverseSTable    LNibbleTable, LInverseNibbleTable ( 8 
+*  ),    ,       .
+*       .
+*     4 .
+*
+* \param [in] engine   .
+*/
+void gost12_15::setEngine(blockEngine engine) {
+    engineChoice choice = { engine, 4 };
+
+    for (int op = 0; op < tunedOperationCount; op++) {
+        for (int size = 0; size < sizeClassCount; size++) {
+            setEngineChoice(static_cast<tunedOperation>(op), static_cast<sizeClass>(size), choice);
+        }
+    }
+}
+
+
+/**
+* \brief   ,     .
+*
+* \return    tunedGamma  sizeLarge.
+*/
+blockEngine gost12_15::getEngine() {
+    return getEngineChoice(tunedGamma, sizeLarge).engine;
+}
+
+
+/**
+* \brief            .
+*
+*   (autotuner)     .
+*     1, 2, 4  8 .    GOST12_15_COMPACT_ENGINE
+*   engineCompact.
+*
+* \param [in] operation   ( /   ).
+* \param [in] size     (. getSizeClass).
+* \param [in] choice     .
+*/
+void gost12_15::setEngineChoice(tunedOperation operation, sizeClass size, engineChoice choice) {
+#ifdef GOST12_15_COMPACT_ENGINE
+    //   ,    
+    choice.engine = engineCompact;
+#endif
+    int interleave = choice.interleave == 1 || choice.interleave == 2 || choice.interleave == 8 ? choice.interleave : 4;
+    engineChoices[operation][size] = static_cast<int>(choice.engine) * 16 + interleave;
+}
+
+
+/**
+* \brief            .
+*
+* \param [in] operation  .
+* \param [in] size    .
+* \return     .
+*/
+engineChoice gost12_15::getEngineChoice(tunedOperation operation, sizeClass size) {
+    int packed = engineChoices[operation][size];
+    engineChoice choice = { static_cast<blockEngine>(packed / 16), packed % 16 };
+    return choice;
+}
+
+
+/**
+* \brief     .
+*
+* \param [in] length     .
+* \return  sizeSmall ( 256 ), sizeMedium ( 16 )  sizeLarge.
+*/
+sizeClass gost12_15::getSizeClass(size_t length) {
+    if (length <= 256) {
+        return sizeSmall;
+    }
+    return length <= 16 * 1024 ? sizeMedium : sizeLarge;
+}
+
+
+/**
+* \brief       .
+*
+* \param [in] choice     .
+* \param [in] key   .
+* \param [in] in   .
+* \param [out] out    (   in).
+* \param [in] blockCount   .
+*/
+void gost12_15::encryptBlocksChoice(engineChoice choice, const expandedKey& key, const uint8_t* in, uint8_t* out,
+                                    size_t blockCount) {
+    GOST_STAT_ADD(counterBlocksEncrypted, blockCount);
+
+    withKuznyechikEngine(*this, choice, [&](const auto& engine, auto lanes) {
+        ecbEncrypt<decltype(lanes)::value>(engine, key, in, out, blockCount);
+    });
+}
+
+
+/**
+* \brief     .
+*
+*      LSXEncryptData,    S  L 
+*   ,   tunedGamma    (. setEngineChoice),
+*         .
+*    initRoundConsts.
+*
+* \param [in] key   .
+* \param [in] in   .
+* \param [out] out    (   in).
+* \param [in] blockCount   .
+*/
+void gost12_15::encryptBlocks(const expandedKey& key, const uint8_t* in, uint8_t* out, size_t blockCount) {
+    encryptBlocksChoice(getEngineChoice(tunedGamma, getSizeClass(blockCount * blockSize)), key, in, out, blockCount);
+}
+
+
+/**
+* \brief     .
+*
+*      LSXDecryptData.     ,
+*   encryptBlocks:   LSInverseTable (64 ),   inverseSTable
+*  LInverseNibbleTable (8 ).
+*    initRoundConsts.
+*
+* \param [in] key    ( ,    ).
+* \param [in] in   .
+* \param [out] out    (   in).
+* \param [in] blockCount   .
+*/
+void gost12_15::decryptBlocks(const expandedKey& key, const uint8_t* in, uint8_t* out, size_t blockCount) {
+    GOST_STAT_ADD(counterBlocksDecrypted, blockCount);
+
+    kuznyechikDecryptKey inverse;
+    withKuznyechikEngine(*this, getEngineChoice(tunedGamma, getSizeClass(blockCount * blockSize)), [&](const auto& engine, auto lanes) {
+        engine.decryptKey(key, inverse);
+        ecbDecrypt<decltype(lanes)::value>(engine, inverse, in, out, blockCount);
+    });
+
+    volatile uint64_t* p = &inverse.roundKeys[0][0];
+    for (int j = 0; j < 20; j++) {
+        p[j] = 0;
+    }
+}
+
+
+/**
+* \brief    .
+*
+*    32   ,   generatingRoundKeys,  LS 
+*     64- ,    .
+*    ,     ,  
+* ,   tunedImito   .
+*    initRoundConsts.
+*
+* \param [in] key    32 .
+* \param [out] expanded   .
+*/
+void gost12_15::expandKey(const uint8_t* key, expandedKey& expanded) {
+    GOST_STAT_ADD(counterKeyExpansions, 1);
+    GOST_STAT_TIMER(operationKeyExpansion);
+
+    withKuznyechikPolicy(*this, getEngineChoice(tunedImito, sizeSmall).engine, [&](const auto& engine) {
+        expandKeyWith(engine.ls, roundConstsWords, key, expanded);
+    });
+}
+
+
+/**
+* \brief      .
+*
+*      (8 )  64-     big-endian.
+*      firstCounter,     .
+*  firstCounter = 1    gammaCryption (   255 ).
+*      encryptBlocks,    .
+*
+* \param [in] key   .
+* \param [in] sync    8 .
+* \param [in] firstCounter    .
+* \param [in] in   .
+* \param [out] out    (   in).
+* \param [in] length     .
+*/
+void gost12_15::gammaCryptionBlocks(const expandedKey& key, const uint8_t* sync, uint64_t firstCounter,
+                                    const uint8_t* in, uint8_t* out, size_t length) {
+    GOST_STAT_ADD(counterGammaBytes, length);
+    GOST_STAT_ADD(counterBlocksEncrypted, (length + blockSize - 1) / blockSize);
+    GOST_STAT_TIMER(operationGamma);
+
+    withKuznyechikEngine(*this, getEngineChoice(tunedGamma, getSizeClass(length)), [&](const auto& engine, auto lanes) {
+        ctrCrypt<decltype(lanes)::value>(engine, key, sync, firstCounter, in, out, length);
+    });
+}
+
+
+/**
+* \brief        .
+*
+*           64 ,  
+*   encryptBlocks,       .  
+*          ,  
+*       .
+*      1,       gammaCryption
+* (   255 ).    .
+*
+* \param [in] key   .
+* \param [in] packets   .
+* \param [in] packetCount   .
+*/
+void gost12_15::gammaCryptionBatch(const expandedKey& key, const packetDescriptor* packets, size_t packetCount) {
+    GOST_STAT_TIMER(operationGamma);
+
+    const size_t laneCount = 64;
+    alignas(16) uint8_t gamma[laneCount * 16];
+    uint8_t* laneData[laneCount];
+    size_t laneLength[laneCount];
+    size_t lanes = 0;
+    size_t p = 0;
+    size_t offset = 0;
+
+    while (true) {
+        while (p < packetCount && lanes < laneCount) {
+            if (offset >= packets[p].length) {
+                GOST_STAT_ADD(counterGammaBytes, packets[p].length);
+                p++;
+                offset = 0;
+                continue;
+            }
+
+            uint64_t counter = offset / blockSize + 1;
+            uint8_t* block = gamma + lanes * blockSize;
+            memcpy(block, packets[p].sync, blockSize / 2);
+            for (int j = 0; j < 8; j++) {
+                block[blockSize - 1 - j] = static_cast<uint8_t>(counter >> (8 * j));
+            }
+
+            size_t rest = packets[p].length - offset;
+            laneData[lanes] = packets[p].data + offset;
+            laneLength[lanes] = rest < static_cast<size_t>(blockSize) ? rest : blockSize;
+            lanes++;
+            offset += blockSize;
+        }
+
+        if (lanes == 0) {
+            break;
+        }
+
+        encryptBlocks(key, gamma, gamma, lanes);
+        for (size_t l = 0; l < lanes; l++) {
+            for (size_t j = 0; j < laneLength[l]; j++) {
+                laneData[l][j] ^= gamma[l * blockSize + j];
+            }
+        }
+        lanes = 0;
+    }
+}
+
+
+/**
+* \brief     .
+*
+* K1       ,    ,  
+*  B128,      . K2   K1   .
+*
+* \param [in] key   .
+* \param [out] k1     (16 ).
+* \param [out] k2     (16 ).
+*/
+void gost12_15::getImitoKeys(const expandedKey& key, uint8_t* k1, uint8_t* k2) {
+    GOST_STAT_ADD(counterBlocksEncrypted, 1);
+
+    withKuznyechikPolicy(*this, getEngineChoice(tunedImito, sizeSmall).engine, [&](const auto& engine) {
+        cmacKeys(engine, key, k1, k2);
+    });
+}
+
+
+/**
+* \brief      .
+*
+*     34.13-2015:       K1, 
+*   1       K2.    
+*    34.13-2015;  imitoGeneration (   
+* getImitoKey  )      .
+*
+* \param [in] key   .
+* \param [in] data  .
+* \param [in] length     .
+* \param [out] imito  .
+* \param [in] imitoLength      (  16).
+*/
+void gost12_15::imitoGenerationBlocks(const expandedKey& key, const uint8_t* data, size_t length,
+                                      uint8_t* imito, size_t imitoLength) {
+    GOST_STAT_ADD(counterImitoBytes, length);
+    GOST_STAT_TIMER(operationImito);
+
+    imitoCompute(key, data, length, imito, imitoLength);
+}
+
+
+/**
+* \brief   .
+*
+*     imitoCompute      ,
+*       .
+*
+* \param [in] key   .
+* \param [in] data  .
+* \param [in] length     .
+* \param [in] imito   .
+* \param [in] imitoLength      ( 1  16).
+* \return  true,   ; false    .
+*/
+bool gost12_15::imitoVerify(const expandedKey& key, const uint8_t* data, size_t length,
+                            const uint8_t* imito, size_t imitoLength) {
+    if (imitoLength == 0 || imitoLength > 16) {
+        return false;
+    }
+
+    GOST_STAT_ADD(counterImitoVerifyBytes, length);
+    GOST_STAT_TIMER(operationImitoVerify);
+
+    uint8_t expected[16];
+    imitoCompute(key, data, length, expected, imitoLength);
+
+    uint8_t difference = 0;
+    for (size_t i = 0; i < imitoLength; i++) {
+        difference |= expected[i] ^ imito[i];
+    }
+
+    return difference == 0;
+}
+
+
+/**
+* \brief       .
+*
+* \param [in] key   .
+* \param [in] data  .
+* \param [in] length     .
+* \param [out] imito  .
+* \param [in] imitoLength      (  16).
+*/
+void gost12_15::imitoCompute(const expandedKey& key, const uint8_t* data, size_t length,
+                             uint8_t* imito, size_t imitoLength) {
+    GOST_STAT_ADD(counterBlocksEncrypted, (length == 0 ? 1 : (length + blockSize - 1) / blockSize) + 1);
+
+    withKuznyechikPolicy(*this, getEngineChoice(tunedImito, getSizeClass(length)).engine, [&](const auto& engine) {
+        cmacCompute(engine, key, data, length, imito, imitoLength);
+    });
+}
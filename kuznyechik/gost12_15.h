@@ -5,6 +5,9 @@
 #include <vector>
 #include <map>
 #include <utility>
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
 
 #include <bitset>
 
@@ -15,7 +18,67 @@ using std::bitset;
 using std::map;
 using std::pair;
 
+/**
+* \brief      .
+*
+*  10      ,     ,
+*     ,  generatingRoundKeys.
+*/
+struct expandedKey {
+    alignas(16) uint8_t roundKeys[10][16];
+};
+
+/**
+* \brief     .
+*
+*       8     .
+*/
+struct packetDescriptor {
+    const uint8_t* sync;
+    uint8_t* data;
+    size_t length;
+};
+
+/**
+* \brief     .
+*/
+enum blockEngine {
+    engineTable = 0,
+    engineCompact = 1
+};
+
+/**
+* \brief ,     .
+*/
+enum tunedOperation {
+    tunedGamma = 0,
+    tunedImito = 1,
+    tunedOperationCount = 2
+};
+
+/**
+* \brief   ,     .
+*/
+enum sizeClass {
+    sizeSmall = 0,
+    sizeMedium = 1,
+    sizeLarge = 2,
+    sizeClassCount = 3
+};
+
+/**
+* \brief  :    ,   .
+*/
+struct engineChoice {
+    blockEngine engine;
+    int interleave;
+};
+
 class gost12_15 {
+    //  (blockEngines.h)    
+    friend struct kuznyechikEngineBase;
+    friend struct kuznyechikTableEngine;
+    friend struct kuznyechikCompactEngine;
 public:
     static gost12_15& getInstance() {
         static gost12_15 g;
@@ -29,6 +92,7 @@ public:
 
     vector<vector<uint8_t>> generatingRoundKeys(vector<uint8_t> key);
     void initRoundConsts();
+    bool isInitialized() const;
 
     vector<uint8_t> inverseData(vector<uint8_t> data);
     vector<uint8_t> LTransformation(vector<uint8_t> data);
@@ -37,8 +101,29 @@ public:
 
     vector<uint8_t> imitoGeneration(vector<uint8_t> data, vector<vector<uint8_t>> roundKeys);
     vector<uint8_t> getImitoKey(vector<vector<uint8_t>> roundKeys);
+
+    void setEngine(blockEngine engine);
+    blockEngine getEngine();
+    void setEngineChoice(tunedOperation operation, sizeClass size, engineChoice choice);
+    engineChoice getEngineChoice(tunedOperation operation, sizeClass size);
+    static sizeClass getSizeClass(size_t length);
+
+    expandedKey packRoundKeys(const vector<vector<uint8_t>>& roundKeys);
+    void expandKey(const uint8_t* key, expandedKey& expanded);
+    void encryptBlocks(const expandedKey& key, const uint8_t* in, uint8_t* out, size_t blockCount);
+    void decryptBlocks(const expandedKey& key, const uint8_t* in, uint8_t* out, size_t blockCount);
+    void gammaCryptionBlocks(const expandedKey& key, const uint8_t* sync, uint64_t firstCounter,
+                             const uint8_t* in, uint8_t* out, size_t length);
+    void gammaCryptionBatch(const expandedKey& key, const packetDescriptor* packets, size_t packetCount);
+    void imitoGenerationBlocks(const expandedKey& key, const uint8_t* data, size_t length,
+                               uint8_t* imito, size_t imitoLength);
+    bool imitoVerify(const expandedKey& key, const uint8_t* data, size_t length,
+                     const uint8_t* imito, size_t imitoLength);
+    void getImitoKeys(const expandedKey& key, uint8_t* k1, uint8_t* k2);
 private:
-    gost12_15() {}
+    gost12_15() {
+        setEngine(engineTable);
+    }
     ~gost12_15() {}
 
     uint8_t lFunc(vector<uint8_t> data);
@@ -55,12 +140,40 @@ private:
     vector<uint8_t> dataXor(vector<uint8_t> data1, vector<uint8_t> data2);
     uint8_t galoisMult(uint8_t polynom1, uint8_t polynom2);
 
+    void initLSTables();
+    void encryptBlocksChoice(engineChoice choice, const expandedKey& key, const uint8_t* in, uint8_t* out,
+                             size_t blockCount);
+    void imitoCompute(const expandedKey& key, const uint8_t* data, size_t length,
+                      uint8_t* imito, size_t imitoLength);
+
     uint8_t generatingPolynom = 0xc3; // x ^ 8 + x ^ 7 + x ^ 6 + x + 1
 
     int blockSize = 16;
     int imitoLen = 8;
 
     vector<vector<uint8_t>> roundConsts;
+    alignas(16) uint64_t roundConstsWords[32][2];
+
+    //  LS : LSTable[i][b]    b   i
+    //(16      64-     )
+    alignas(64) uint64_t LSTable[16][256][2];
+
+    //  L : LNibbleTable[2 * i + h][n]    n
+    //(  h = 0,   h = 1)    i
+    alignas(64) uint64_t LNibbleTable[32][16][2];
+
+    //  : LSInverseTable[i][b]   L^-1  S^-1(b)   i
+    alignas(64) uint64_t LSInverseTable[16][256][2];
+
+    //   : LInverseNibbleTable[2 * i + h][n]   L^-1  n
+    //   i (S^-1    inverseSTable)
+    alignas(64) uint64_t LInverseNibbleTable[32][16][2];
+
+    // : engineChoices[][ ] =  * 16 +  
+    std::atomic<int> engineChoices[tunedOperationCount][sizeClassCount];
+
+    //     (   initRoundConsts)
+    std::atomic<bool> initialized{ false };
 
 
     //   l   
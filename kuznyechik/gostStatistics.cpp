@@ -0,0 +1,287 @@
+#include "gostStatistics.h"
+
+#include <sstream>
+#include <algorithm>
+
+#include "gost12_15.h"
+
+
+namespace {
+
+const char* counterNames[counterCount] = {
+    "blocks_encrypted",
+    "blocks_decrypted",
+    "gamma_bytes",
+    "imito_bytes",
+    "imito_verify_bytes",
+    "key_expansions"
+};
+
+const char* operationNames[operationCount] = {
+    "gamma",
+    "imito",
+    "imito_verify",
+    "key_expansion"
+};
+
+const char* counterHelp[counterCount] = {
+    "Blocks encrypted.",
+    "Blocks decrypted.",
+    "Bytes processed in gamma mode.",
+    "Bytes authenticated by imito generation.",
+    "Bytes authenticated by imito verification.",
+    "Round key expansions."
+};
+
+const char* tunedOperationNames[tunedOperationCount] = { "gamma", "imito" };
+const char* sizeClassNames[sizeClassCount] = { "small", "medium", "large" };
+const char* engineNames[] = { "table", "compact" };
+
+}
+
+
+gostStatistics::threadStatisticsHolder::~threadStatisticsHolder() {
+    if (statistics) {
+        gostStatistics::getInstance().retireThread(statistics);
+    }
+}
+
+
+gostStatistics::~gostStatistics() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < threads.size(); i++) {
+        delete threads[i];
+    }
+    threads.clear();
+}
+
+
+/**
+* \brief     .
+*
+* \return    .
+*/
+threadStatistics* gostStatistics::registerThread() {
+    threadStatistics* statistics = new threadStatistics();
+    for (int i = 0; i < counterCount; i++) {
+        statistics->counters[i].store(0, std::memory_order_relaxed);
+        statistics->counterBaseline[i].store(0, std::memory_order_relaxed);
+    }
+    for (int i = 0; i < operationCount; i++) {
+        for (int b = 0; b < statisticsHistogramBuckets; b++) {
+            statistics->latencyHistogram[i][b].store(0, std::memory_order_relaxed);
+            statistics->histogramBaseline[i][b].store(0, std::memory_order_relaxed);
+        }
+        statistics->latencySum[i].store(0, std::memory_order_relaxed);
+        statistics->latencySumBaseline[i].store(0, std::memory_order_relaxed);
+    }
+    statistics->sampleCountdown = 0;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    threads.push_back(statistics);
+    return statistics;
+}
+
+
+/**
+* \brief        .
+*
+* \param [in] statistics   .
+*/
+void gostStatistics::retireThread(threadStatistics* statistics) {
+    std::lock_guard<std::mutex> lock(mutex);
+    accumulate(*statistics, retired);
+    threads.erase(std::remove(threads.begin(), threads.end(), statistics), threads.end());
+    delete statistics;
+}
+
+
+/**
+* \brief            reset.
+*
+* \param [in] statistics   .
+* \param [in,out] snapshot  .
+*/
+void gostStatistics::accumulate(const threadStatistics& statistics, statisticsSnapshot& snapshot) {
+    for (int i = 0; i < counterCount; i++) {
+        snapshot.counters[i] += statistics.counters[i].load(std::memory_order_relaxed)
+            - statistics.counterBaseline[i].load(std::memory_order_relaxed);
+    }
+    for (int i = 0; i < operationCount; i++) {
+        for (int b = 0; b < statisticsHistogramBuckets; b++) {
+            snapshot.latencyHistogram[i][b] += statistics.latencyHistogram[i][b].load(std::memory_order_relaxed)
+                - statistics.histogramBaseline[i][b].load(std::memory_order_relaxed);
+        }
+        snapshot.latencySum[i] += statistics.latencySum[i].load(std::memory_order_relaxed)
+            - statistics.latencySumBaseline[i].load(std::memory_order_relaxed);
+    }
+}
+
+
+/**
+* \brief        .
+*
+* \param [in,out] snapshot  .
+*/
+void gostStatistics::fillEngines(statisticsSnapshot& snapshot) {
+    gost12_15& g = gost12_15::getInstance();
+    for (int op = 0; op < tunedOperationCount; op++) {
+        for (int size = 0; size < sizeClassCount; size++) {
+            snapshot.engines[op][size] = g.getEngineChoice(static_cast<tunedOperation>(op), static_cast<sizeClass>(size));
+        }
+    }
+}
+
+
+/**
+* \brief        .
+*
+* \param [in] operation  .
+* \param [in] nanoseconds     .
+*/
+void gostStatistics::recordLatency(statisticsOperation operation, uint64_t nanoseconds) {
+    threadStatistics& s = local();
+    std::atomic<uint64_t>& sum = s.latencySum[operation];
+    sum.store(sum.load(std::memory_order_relaxed) + nanoseconds, std::memory_order_relaxed);
+
+    int bucket = 0;
+    while (nanoseconds > 1 && bucket < statisticsHistogramBuckets - 1) {
+        nanoseconds >>= 1;
+        bucket++;
+    }
+
+    std::atomic<uint64_t>& c = s.latencyHistogram[operation][bucket];
+    c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+
+/**
+* \brief     .
+*
+* \param [in] interval    interval-     (0  ).
+*/
+void gostStatistics::setSamplingInterval(unsigned interval) {
+    samplingInterval.store(interval, std::memory_order_relaxed);
+}
+
+
+/**
+* \brief    ,    .
+*
+* \return      .
+*/
+statisticsSnapshot gostStatistics::snapshot() {
+    std::lock_guard<std::mutex> lock(mutex);
+    statisticsSnapshot result = retired;
+    for (size_t i = 0; i < threads.size(); i++) {
+        accumulate(*threads[i], result);
+    }
+
+#ifdef GOST12_15_STATISTICS
+    result.enabled = true;
+#else
+    result.enabled = false;
+#endif
+    fillEngines(result);
+    return result;
+}
+
+
+/**
+* \brief      .
+*
+*   ,      ,     .
+*
+* \return        .
+*/
+statisticsSnapshot gostStatistics::threadSnapshot() {
+    statisticsSnapshot result = {};
+    accumulate(local(), result);
+
+#ifdef GOST12_15_STATISTICS
+    result.enabled = true;
+#else
+    result.enabled = false;
+#endif
+    fillEngines(result);
+    return result;
+}
+
+
+/**
+* \brief     .
+*
+*    :       
+*  . ,     ,  .
+*/
+void gostStatistics::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    retired = statisticsSnapshot();
+    for (size_t i = 0; i < threads.size(); i++) {
+        for (int c = 0; c < counterCount; c++) {
+            threads[i]->counterBaseline[c].store(threads[i]->counters[c].load(std::memory_order_relaxed),
+                                                 std::memory_order_relaxed);
+        }
+        for (int o = 0; o < operationCount; o++) {
+            for (int b = 0; b < statisticsHistogramBuckets; b++) {
+                threads[i]->histogramBaseline[o][b].store(
+                    threads[i]->latencyHistogram[o][b].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+            threads[i]->latencySumBaseline[o].store(threads[i]->latencySum[o].load(std::memory_order_relaxed),
+                                                    std::memory_order_relaxed);
+        }
+    }
+}
+
+
+/**
+* \brief       Prometheus.
+*
+*     # HELP  # TYPE.   
+*        gost12_15_engine,   
+* ,  (_sum)    (_count).
+*
+* \param [in] snapshot   .
+* \return   .
+*/
+std::string gostStatistics::format(const statisticsSnapshot& snapshot) {
+    std::ostringstream out;
+
+    out << "# HELP gost12_15_statistics_enabled Whether the library was built with GOST12_15_STATISTICS.\n"
+        << "# TYPE gost12_15_statistics_enabled gauge\n"
+        << "gost12_15_statistics_enabled " << (snapshot.enabled ? 1 : 0) << "\n";
+
+    out << "# HELP gost12_15_engine Block engine and interleave selected per operation and size class.\n"
+        << "# TYPE gost12_15_engine gauge\n";
+    for (int op = 0; op < tunedOperationCount; op++) {
+        for (int size = 0; size < sizeClassCount; size++) {
+            const engineChoice& choice = snapshot.engines[op][size];
+            out << "gost12_15_engine{operation=\"" << tunedOperationNames[op] << "\",size=\"" << sizeClassNames[size]
+                << "\",engine=\"" << engineNames[choice.engine] << "\",interleave=\"" << choice.interleave << "\"} 1\n";
+        }
+    }
+
+    for (int i = 0; i < counterCount; i++) {
+        out << "# HELP gost12_15_" << counterNames[i] << " " << counterHelp[i] << "\n"
+            << "# TYPE gost12_15_" << counterNames[i] << " counter\n"
+            << "gost12_15_" << counterNames[i] << " " << snapshot.counters[i] << "\n";
+    }
+
+    out << "# HELP gost12_15_latency_ns Sampled operation latency in nanoseconds.\n"
+        << "# TYPE gost12_15_latency_ns histogram\n";
+    for (int i = 0; i < operationCount; i++) {
+        uint64_t cumulative = 0;
+        for (int b = 0; b < statisticsHistogramBuckets; b++) {
+            cumulative += snapshot.latencyHistogram[i][b];
+            if (snapshot.latencyHistogram[i][b] != 0) {
+                out << "gost12_15_latency_ns_bucket{operation=\"" << operationNames[i]
+                    << "\",le=\"" << (static_cast<uint64_t>(2) << b) << "\"} " << cumulative << "\n";
+            }
+        }
+        out << "gost12_15_latency_ns_bucket{operation=\"" << operationNames[i] << "\",le=\"+Inf\"} " << cumulative << "\n";
+        out << "gost12_15_latency_ns_sum{operation=\"" << operationNames[i] << "\"} " << snapshot.latencySum[i] << "\n";
+        out << "gost12_15_latency_ns_count{operation=\"" << operationNames[i] << "\"} " << cumulative << "\n";
+    }
+
+    return out.str();
+}
@@ -0,0 +1,175 @@
+#ifndef _GOST_STATISTICS_H_
+#define _GOST_STATISTICS_H_
+
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "gost12_15.h"
+
+/**
+* \brief   .
+*/
+enum statisticsCounter {
+    counterBlocksEncrypted = 0,
+    counterBlocksDecrypted,
+    counterGammaBytes,
+    counterImitoBytes,
+    counterImitoVerifyBytes,
+    counterKeyExpansions,
+    counterCount
+};
+
+/**
+* \brief ,     .
+*/
+enum statisticsOperation {
+    operationGamma = 0,
+    operationImito,
+    operationImitoVerify,
+    operationKeyExpansion,
+    operationCount
+};
+
+const int statisticsHistogramBuckets = 32;
+
+/**
+* \brief   .
+*
+* latencyHistogram[op][b]     op   2^b  2^(b+1) ,
+* latencySum[op]       ,
+* engines            .
+*/
+struct statisticsSnapshot {
+    bool enabled;
+    engineChoice engines[tunedOperationCount][sizeClassCount];
+    uint64_t counters[counterCount];
+    uint64_t latencyHistogram[operationCount][statisticsHistogramBuckets];
+    uint64_t latencySum[operationCount];
+};
+
+/**
+* \brief   .    ,    .
+*
+*    reset ( )     ,
+*              .
+*/
+struct threadStatistics {
+    std::atomic<uint64_t> counters[counterCount];
+    std::atomic<uint64_t> latencyHistogram[operationCount][statisticsHistogramBuckets];
+    std::atomic<uint64_t> latencySum[operationCount];
+    std::atomic<uint64_t> counterBaseline[counterCount];
+    std::atomic<uint64_t> histogramBaseline[operationCount][statisticsHistogramBuckets];
+    std::atomic<uint64_t> latencySumBaseline[operationCount];
+    unsigned sampleCountdown;
+};
+
+/**
+* \brief      gost12_15.
+*
+*          read-modify-write ,
+*      ( ); reset   
+* ,     .
+*   :      samplingInterval- .
+*      GOST_STAT_ADD  GOST_STAT_TIMER, 
+*    ,    GOST12_15_STATISTICS
+* (   Debug ;     -DGOST12_15_STATISTICS).
+*/
+class gostStatistics {
+public:
+    static gostStatistics& getInstance() {
+        static gostStatistics s;
+        return s;
+    }
+
+    inline void add(statisticsCounter counter, uint64_t value) {
+        std::atomic<uint64_t>& c = local().counters[counter];
+        c.store(c.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    inline bool sampleLatency() {
+        unsigned interval = samplingInterval.load(std::memory_order_relaxed);
+        if (interval == 0) {
+            return false;
+        }
+
+        threadStatistics& s = local();
+        if (s.sampleCountdown == 0 || s.sampleCountdown > interval) {
+            s.sampleCountdown = interval;
+        }
+        return --s.sampleCountdown == 0;
+    }
+
+    void recordLatency(statisticsOperation operation, uint64_t nanoseconds);
+
+    void setSamplingInterval(unsigned interval);
+    statisticsSnapshot snapshot();
+    statisticsSnapshot threadSnapshot();
+    void reset();
+
+    static std::string format(const statisticsSnapshot& snapshot);
+private:
+    struct threadStatisticsHolder {
+        threadStatistics* statistics = nullptr;
+        ~threadStatisticsHolder();
+    };
+
+    gostStatistics() {}
+    ~gostStatistics();
+
+    inline threadStatistics& local() {
+        static thread_local threadStatisticsHolder holder;
+        if (!holder.statistics) {
+            holder.statistics = registerThread();
+        }
+        return *holder.statistics;
+    }
+
+    threadStatistics* registerThread();
+    void retireThread(threadStatistics* statistics);
+    void accumulate(const threadStatistics& statistics, statisticsSnapshot& snapshot);
+    static void fillEngines(statisticsSnapshot& snapshot);
+
+    std::atomic<unsigned> samplingInterval{ 64 };
+
+    std::mutex mutex;
+    std::vector<threadStatistics*> threads;
+    statisticsSnapshot retired = {};
+};
+
+/**
+* \brief        (   ).
+*/
+class statisticsTimer {
+public:
+    explicit statisticsTimer(statisticsOperation operation)
+        : operation(operation), sampled(gostStatistics::getInstance().sampleLatency()) {
+        if (sampled) {
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~statisticsTimer() {
+        if (sampled) {
+            gostStatistics::getInstance().recordLatency(operation, static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+        }
+    }
+private:
+    statisticsOperation operation;
+    bool sampled;
+    std::chrono::steady_clock::time_point start;
+};
+
+#ifdef GOST12_15_STATISTICS
+#define GOST_STAT_ADD(counter, value) gostStatistics::getInstance().add((counter), (value))
+#define GOST_STAT_TIMER(operation) statisticsTimer gostStatisticsTimer((operation))
+#else
+#define GOST_STAT_ADD(counter, value) ((void)0)
+#define GOST_STAT_TIMER(operation) ((void)0)
+#endif
+
+#endif
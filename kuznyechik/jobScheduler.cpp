@@ -0,0 +1,319 @@
+#include "jobScheduler.h"
+
+#include <algorithm>
+
+
+namespace {
+
+const size_t blockSize = 16;
+
+//      
+thread_local const void* currentScheduler = nullptr;
+thread_local size_t currentQueue = 0;
+
+}
+
+
+/**
+* \brief   .
+*
+* \param [in] threadCount     (0     ).
+* \param [in] chunkSize      (    16 ).
+* \param [in] packSize    ,   .
+*/
+jobScheduler::jobScheduler(unsigned threadCount, size_t chunkSize, size_t packSize)
+    : chunkSize((chunkSize + blockSize - 1) / blockSize * blockSize), packSize(packSize) {
+    if (this->chunkSize == 0) {
+        this->chunkSize = blockSize;
+    }
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+
+    for (unsigned i = 0; i < threadCount; i++) {
+        queues.push_back(std::unique_ptr<workerQueue>(new workerQueue()));
+    }
+    for (unsigned i = 0; i < threadCount; i++) {
+        workers.push_back(std::thread(&jobScheduler::workerLoop, this, i));
+    }
+}
+
+
+jobScheduler::~jobScheduler() {
+    wait();
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeup.notify_all();
+
+    for (size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+}
+
+
+/**
+* \brief     .
+*
+* \param [in] job  .
+*/
+void jobScheduler::submit(const cryptoJob& job) {
+    submit(&job, 1);
+}
+
+
+/**
+* \brief      .
+*
+*       chunkSize ,  (  packSize)
+*       chunkSize.
+*
+* \param [in] jobs  .
+* \param [in] count   .
+*/
+void jobScheduler::submit(const cryptoJob* jobs, size_t count) {
+    std::vector<task> tasks;
+    task pack = { nullptr, 0, 0, true };
+    jobState* packTail = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        pendingJobs += count;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        jobState* state = new jobState();
+        state->job = jobs[i];
+        state->packNext = nullptr;
+
+        submittedJobs++;
+        submittedBytes += jobs[i].length;
+
+        if (jobs[i].length <= packSize) {
+            state->remainingChunks = 1;
+            if (packTail) {
+                packTail->packNext = state;
+            }
+            else {
+                pack.job = state;
+            }
+            packTail = state;
+            pack.length += jobs[i].length;
+
+            if (pack.length >= chunkSize) {
+                tasks.push_back(pack);
+                pack.job = nullptr;
+                pack.length = 0;
+                packTail = nullptr;
+            }
+            continue;
+        }
+
+        size_t chunks = (jobs[i].length + chunkSize - 1) / chunkSize;
+        state->remainingChunks = chunks;
+        for (size_t offset = 0; offset < jobs[i].length; offset += chunkSize) {
+            task chunk = { state, offset, std::min(chunkSize, jobs[i].length - offset), false };
+            tasks.push_back(chunk);
+        }
+    }
+
+    if (pack.job) {
+        tasks.push_back(pack);
+    }
+
+    push(tasks);
+}
+
+
+/**
+* \brief      .
+*
+*     completion.
+*/
+void jobScheduler::wait() {
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    idle.wait(lock, [this] { return pendingJobs == 0; });
+}
+
+
+unsigned jobScheduler::threadCount() const {
+    return static_cast<unsigned>(workers.size());
+}
+
+
+/**
+* \brief     .
+*
+* \return   , , -,    .
+*/
+schedulerStatistics jobScheduler::statistics() {
+    schedulerStatistics s;
+    s.jobs = submittedJobs;
+    s.bytes = submittedBytes;
+    s.chunkTasks = chunkTasks;
+    s.packedTasks = packedTasks;
+    s.steals = steals;
+    return s;
+}
+
+
+/**
+* \brief     .
+*
+*   (,  completion)     ,   
+*      ,     .
+*
+* \param [in] tasks  .
+*/
+void jobScheduler::push(const std::vector<task>& tasks) {
+    if (tasks.empty()) {
+        return;
+    }
+
+    //    :       
+    //   queuedTasks  .
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queuedTasks += tasks.size();
+    }
+
+    size_t index = currentScheduler == this ? currentQueue : nextQueue++ % queues.size();
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.insert(queues[index]->tasks.end(), tasks.begin(), tasks.end());
+    }
+
+    if (tasks.size() == 1) {
+        wakeup.notify_one();
+    }
+    else {
+        wakeup.notify_all();
+    }
+}
+
+
+bool jobScheduler::pop(size_t index, task& t) {
+    std::lock_guard<std::mutex> lock(queues[index]->mutex);
+    if (queues[index]->tasks.empty()) {
+        return false;
+    }
+
+    t = queues[index]->tasks.back();
+    queues[index]->tasks.pop_back();
+    return true;
+}
+
+
+bool jobScheduler::steal(size_t index, task& t) {
+    for (size_t i = 1; i < queues.size(); i++) {
+        workerQueue& victim = *queues[(index + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            t = victim.tasks.front();
+            victim.tasks.pop_front();
+            steals++;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void jobScheduler::workerLoop(size_t index) {
+    currentScheduler = this;
+    currentQueue = index;
+
+    for (;;) {
+        task t;
+        if (pop(index, t) || steal(index, t)) {
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+                queuedTasks--;
+            }
+            run(t);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeup.wait(lock, [this] { return stopping || queuedTasks > 0; });
+        if (stopping && queuedTasks == 0) {
+            return;
+        }
+    }
+}
+
+
+/**
+* \brief   :       .
+*
+*    offset      1 + offset / 16,
+*        .
+*
+* \param [in] t  .
+*/
+void jobScheduler::run(const task& t) {
+    gost12_15 &g = gost12_15::getInstance();
+
+    if (!t.packed) {
+        chunkTasks++;
+        const cryptoJob& job = t.job->job;
+        g.gammaCryptionBlocks(job.key, job.sync, 1 + t.offset / blockSize, job.in + t.offset, job.out + t.offset,
+                              t.length);
+        chunkDone(t.job);
+        return;
+    }
+
+    packedTasks++;
+    jobState* state = t.job;
+    while (state) {
+        jobState* next = state->packNext;
+        const cryptoJob& job = state->job;
+        g.gammaCryptionBlocks(job.key, job.sync, 1, job.in, job.out, job.length);
+        chunkDone(state);
+        state = next;
+    }
+}
+
+
+/**
+* \brief     .
+*
+* ,   ,        .
+*
+* \param [in] state  .
+*/
+void jobScheduler::chunkDone(jobState* state) {
+    if (state->remainingChunks.fetch_sub(1) != 1) {
+        return;
+    }
+
+    const cryptoJob& job = state->job;
+    if (job.imito) {
+        gost12_15::getInstance().imitoGenerationBlocks(job.key, job.out, job.length, job.imito, job.imitoLength);
+    }
+
+    complete(state);
+}
+
+
+void jobScheduler::complete(jobState* state) {
+    if (state->job.completion) {
+        state->job.completion(state->job);
+    }
+    delete state;
+
+    bool last;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        last = --pendingJobs == 0;
+    }
+    if (last) {
+        idle.notify_all();
+    }
+}
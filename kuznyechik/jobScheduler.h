@@ -0,0 +1,116 @@
+#ifndef _JOB_SCHEDULER_H_
+#define _JOB_SCHEDULER_H_
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <atomic>
+
+#include "gost12_15.h"
+
+/**
+* \brief  :  in  out    .
+*
+*    gammaCryptionBlocks(key, sync, 1, ...).  imito   nullptr,
+*        imitoLength  out.
+*  in, out  imito     completion.
+*/
+struct cryptoJob {
+    expandedKey key;
+    uint8_t sync[8];
+    const uint8_t* in;
+    uint8_t* out;
+    size_t length;
+    uint8_t* imito;
+    size_t imitoLength;
+    std::function<void(const cryptoJob& job)> completion;
+};
+
+/**
+* \brief   .
+*/
+struct schedulerStatistics {
+    uint64_t jobs;
+    uint64_t bytes;
+    uint64_t chunkTasks;
+    uint64_t packedTasks;
+    uint64_t steals;
+};
+
+/**
+* \brief         .
+*
+*   chunkSize     chunkSize ,   
+*      .    packSize, 
+*   submit,       chunkSize.
+*        ,      
+*     ,       .
+* completion           .
+*/
+class jobScheduler {
+public:
+    explicit jobScheduler(unsigned threadCount = 0, size_t chunkSize = 64 * 1024, size_t packSize = 4 * 1024);
+    ~jobScheduler();
+
+    jobScheduler(const jobScheduler&) = delete;
+    jobScheduler& operator=(const jobScheduler&) = delete;
+
+    void submit(const cryptoJob& job);
+    void submit(const cryptoJob* jobs, size_t count);
+    void wait();
+
+    unsigned threadCount() const;
+    schedulerStatistics statistics();
+private:
+    struct jobState {
+        cryptoJob job;
+        std::atomic<size_t> remainingChunks;
+        jobState* packNext;
+    };
+
+    struct task {
+        jobState* job;
+        size_t offset;
+        size_t length;
+        bool packed;
+    };
+
+    struct workerQueue {
+        std::mutex mutex;
+        std::deque<task> tasks;
+    };
+
+    void workerLoop(size_t index);
+    void push(const std::vector<task>& tasks);
+    bool pop(size_t index, task& t);
+    bool steal(size_t index, task& t);
+    void run(const task& t);
+    void chunkDone(jobState* state);
+    void complete(jobState* state);
+
+    size_t chunkSize;
+    size_t packSize;
+
+    std::vector<std::unique_ptr<workerQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> nextQueue{ 0 };
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeup;
+    std::condition_variable idle;
+    size_t queuedTasks = 0;
+    size_t pendingJobs = 0;
+    bool stopping = false;
+
+    std::atomic<uint64_t> submittedJobs{ 0 };
+    std::atomic<uint64_t> submittedBytes{ 0 };
+    std::atomic<uint64_t> chunkTasks{ 0 };
+    std::atomic<uint64_t> packedTasks{ 0 };
+    std::atomic<uint64_t> steals{ 0 };
+};
+
+#endif
@@ -0,0 +1,189 @@
+#include "keyScheduleCache.h"
+
+#include <cstring>
+#include <random>
+#include <iterator>
+
+
+namespace {
+
+const size_t keySize = 32;
+
+
+void secureZero(void* data, size_t length) {
+    volatile uint8_t* p = static_cast<volatile uint8_t*>(data);
+    for (size_t i = 0; i < length; i++) {
+        p[i] = 0;
+    }
+}
+
+}
+
+
+/**
+* \brief    .
+*
+* \param [in] capacity      .
+*/
+keyScheduleCache::keyScheduleCache(size_t capacity)
+    : capacity(capacity == 0 ? 1 : capacity) {
+    std::random_device random;
+    seed = (static_cast<uint64_t>(random()) << 32) ^ random();
+}
+
+
+keyScheduleCache::~keyScheduleCache() {
+    clear();
+}
+
+
+/**
+* \brief    .
+*
+*        ,     .
+*          .
+*
+* \param [in] key    32 .
+* \return  64-  .
+*/
+uint64_t keyScheduleCache::fingerprint(const uint8_t* key) const {
+    uint64_t h = seed;
+
+    for (size_t i = 0; i < keySize; i += 8) {
+        uint64_t word;
+        memcpy(&word, key + i, 8);
+        h ^= word;
+        h *= 0x9e3779b97f4a7c15ULL;
+        h ^= h >> 29;
+    }
+
+    return h;
+}
+
+
+void keyScheduleCache::evict(std::list<entry>::iterator it) {
+    auto range = index.equal_range(it->fingerprint);
+    for (auto i = range.first; i != range.second; ++i) {
+        if (i->second == it) {
+            index.erase(i);
+            break;
+        }
+    }
+
+    secureZero(&*it, sizeof(entry));
+    entries.erase(it);
+}
+
+
+/**
+* \brief      .
+*
+*         expandKey  
+*    ,       .
+*
+* \param [in] key    32 .
+* \param [out] expanded   .
+*/
+void keyScheduleCache::get(const uint8_t* key, expandedKey& expanded) {
+    uint64_t fp = fingerprint(key);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    auto range = index.equal_range(fp);
+    for (auto i = range.first; i != range.second; ++i) {
+        if (memcmp(i->second->key, key, keySize) == 0) {
+            entries.splice(entries.begin(), entries, i->second);
+            expanded = i->second->expanded;
+            stats.hits++;
+            return;
+        }
+    }
+    stats.misses++;
+    lock.unlock();
+
+    gost12_15::getInstance().expandKey(key, expanded);
+
+    lock.lock();
+    range = index.equal_range(fp);
+    for (auto i = range.first; i != range.second; ++i) {
+        if (memcmp(i->second->key, key, keySize) == 0) {
+            return;
+        }
+    }
+
+    while (entries.size() >= capacity) {
+        evict(std::prev(entries.end()));
+        stats.evictions++;
+    }
+
+    entries.push_front(entry());
+    entry& e = entries.front();
+    e.fingerprint = fp;
+    memcpy(e.key, key, keySize);
+    e.expanded = expanded;
+    index.insert(std::make_pair(fp, entries.begin()));
+}
+
+
+/**
+* \brief      .
+*
+* \param [in] key    32 .
+* \param [out] expanded   .
+* \return  false    .
+*/
+bool keyScheduleCache::get(const vector<uint8_t>& key, expandedKey& expanded) {
+    if (key.size() != keySize) {
+        return false;
+    }
+
+    get(key.data(), expanded);
+    return true;
+}
+
+
+/**
+* \brief        .
+*
+* \param [in] key    32 .
+* \return  false,      .
+*/
+bool keyScheduleCache::erase(const uint8_t* key) {
+    uint64_t fp = fingerprint(key);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto range = index.equal_range(fp);
+    for (auto i = range.first; i != range.second; ++i) {
+        if (memcmp(i->second->key, key, keySize) == 0) {
+            evict(i->second);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/**
+* \brief       .
+*/
+void keyScheduleCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        secureZero(&*it, sizeof(entry));
+    }
+    entries.clear();
+    index.clear();
+}
+
+
+/**
+* \brief     .
+*
+* \return   , ,     .
+*/
+keyCacheStatistics keyScheduleCache::statistics() {
+    std::lock_guard<std::mutex> lock(mutex);
+    keyCacheStatistics snapshot = stats;
+    snapshot.size = entries.size();
+    return snapshot;
+}
@@ -0,0 +1,60 @@
+#ifndef _KEY_SCHEDULE_CACHE_H_
+#define _KEY_SCHEDULE_CACHE_H_
+
+#include <list>
+#include <unordered_map>
+#include <mutex>
+
+#include "gost12_15.h"
+
+/**
+* \brief    .
+*/
+struct keyCacheStatistics {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t size;
+};
+
+/**
+* \brief     .
+*
+*    64- ,      ,
+*     .       .
+*     .
+*/
+class keyScheduleCache {
+public:
+    explicit keyScheduleCache(size_t capacity = 1024);
+    ~keyScheduleCache();
+
+    keyScheduleCache(const keyScheduleCache&) = delete;
+    keyScheduleCache& operator=(const keyScheduleCache&) = delete;
+
+    void get(const uint8_t* key, expandedKey& expanded);
+    bool get(const vector<uint8_t>& key, expandedKey& expanded);
+    bool erase(const uint8_t* key);
+    void clear();
+
+    keyCacheStatistics statistics();
+private:
+    struct entry {
+        uint64_t fingerprint;
+        uint8_t key[32];
+        expandedKey expanded;
+    };
+
+    uint64_t fingerprint(const uint8_t* key) const;
+    void evict(std::list<entry>::iterator it);
+
+    size_t capacity;
+    uint64_t seed;
+
+    std::mutex mutex;
+    std::list<entry> entries;
+    std::unordered_multimap<uint64_t, std::list<entry>::iterator> index;
+    keyCacheStatistics stats = {};
+};
+
+#endif
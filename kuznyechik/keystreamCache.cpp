@@ -0,0 +1,215 @@
+#include "keystreamCache.h"
+
+#include <cstring>
+
+#include "bufferPool.h"
+
+
+namespace {
+
+const size_t blockSize = 16;
+const size_t producerChunk = 4096;
+
+}
+
+
+/**
+* \brief   .
+*
+* \param [in] key   .
+* \param [in] sync    8 .
+* \param [in] capacity       (    4096).
+* \param [in] firstCounter      (1  gammaCryption).
+*/
+keystreamCache::keystreamCache(const expandedKey& key, const vector<uint8_t>& sync, size_t capacity,
+                               uint64_t firstCounter)
+    : key(key), firstCounter(firstCounter) {
+    memset(this->sync, 0, sizeof(this->sync));
+    memcpy(this->sync, sync.data(), sync.size() < sizeof(this->sync) ? sync.size() : sizeof(this->sync));
+
+    capacity = (capacity + producerChunk - 1) / producerChunk * producerChunk;
+    ring.assign(capacity == 0 ? producerChunk : capacity, 0);
+
+    producer = std::thread(&keystreamCache::producerLoop, this);
+}
+
+
+/**
+* \brief   .
+*
+*          .
+*/
+keystreamCache::~keystreamCache() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    spaceCondition.notify_all();
+    producer.join();
+
+    volatile uint8_t* p = ring.data();
+    for (size_t i = 0; i < ring.size(); i++) {
+        p[i] = 0;
+    }
+    p = &key.roundKeys[0][0];
+    for (size_t i = 0; i < sizeof(key); i++) {
+        p[i] = 0;
+    }
+}
+
+
+/**
+* \brief   ,      .
+*
+* \param [in] offset        ( 16).
+* \param [out] gamma    .
+* \param [in] length      ( 16).
+*/
+void keystreamCache::generate(uint64_t offset, uint8_t* gamma, size_t length) {
+    memset(gamma, 0, length);
+    gost12_15::getInstance().gammaCryptionBlocks(key, sync, firstCounter + offset / blockSize, gamma, gamma, length);
+}
+
+
+void keystreamCache::xorFromRing(uint64_t offset, const uint8_t* in, uint8_t* out, size_t length) {
+    while (length > 0) {
+        size_t position = static_cast<size_t>(offset % ring.size());
+        size_t chunk = ring.size() - position < length ? ring.size() - position : length;
+        for (size_t i = 0; i < chunk; i++) {
+            out[i] = in[i] ^ ring[position + i];
+        }
+        in += chunk;
+        out += chunk;
+        offset += chunk;
+        length -= chunk;
+    }
+}
+
+
+void keystreamCache::storeToRing(uint64_t offset, const uint8_t* gamma, size_t length) {
+    while (length > 0) {
+        size_t position = static_cast<size_t>(offset % ring.size());
+        size_t chunk = ring.size() - position < length ? ring.size() - position : length;
+        memcpy(ring.data() + position, gamma, chunk);
+        gamma += chunk;
+        offset += chunk;
+        length -= chunk;
+    }
+}
+
+
+/**
+* \brief   ,   .
+*
+*           ,  
+*         (   produced  ).
+*/
+void keystreamCache::producerLoop() {
+    poolBuffer gamma(producerChunk);
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true) {
+        spaceCondition.wait(lock, [this] {
+            return stopping || ring.size() - static_cast<size_t>(produced - consumed) >= producerChunk;
+        });
+        if (stopping) {
+            break;
+        }
+
+        uint64_t offset = produced;
+        lock.unlock();
+        generate(offset, gamma.data(), producerChunk);
+        lock.lock();
+
+        if (produced == offset) {
+            storeToRing(offset, gamma.data(), producerChunk);
+            produced += producerChunk;
+            stats.generatedBytes += producerChunk;
+        }
+        else {
+            stats.discardedBytes += producerChunk;
+        }
+    }
+}
+
+
+/**
+* \brief        .
+*
+*          .  
+*    ,         ;
+*          .
+*
+* \param [in] in   .
+* \param [out] out    (   in).
+* \param [in] length     .
+*/
+void keystreamCache::gammaCryption(const uint8_t* in, uint8_t* out, size_t length) {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    size_t ready = static_cast<size_t>(produced - consumed);
+    if (ready >= length) {
+        xorFromRing(consumed, in, out, length);
+        consumed += length;
+        stats.hits++;
+        stats.hitBytes += length;
+        lock.unlock();
+        spaceCondition.notify_one();
+        return;
+    }
+
+    xorFromRing(consumed, in, out, ready);
+    uint64_t offset = consumed + ready;
+    uint64_t end = offset + (length - ready);
+    uint64_t alignedEnd = (end + blockSize - 1) / blockSize * blockSize;
+
+    poolBuffer gamma(static_cast<size_t>(alignedEnd - offset));
+    generate(offset, gamma.data(), gamma.size());
+    for (size_t i = 0; i < length - ready; i++) {
+        out[ready + i] = in[ready + i] ^ gamma.data()[i];
+    }
+
+    storeToRing(end, gamma.data() + (length - ready), static_cast<size_t>(alignedEnd - end));
+    consumed = end;
+    produced = alignedEnd;
+    stats.misses++;
+    stats.hitBytes += ready;
+    stats.missBytes += length - ready;
+    lock.unlock();
+    spaceCondition.notify_one();
+}
+
+
+/**
+* \brief        .
+*
+* \param [in] data   .
+* \return   .
+*/
+vector<uint8_t> keystreamCache::gammaCryption(const vector<uint8_t>& data) {
+    vector<uint8_t> result(data.size(), 0);
+    gammaCryption(data.data(), result.data(), data.size());
+    return result;
+}
+
+
+/**
+* \brief     .
+*
+* \return    ,   .
+*/
+size_t keystreamCache::available() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<size_t>(produced - consumed);
+}
+
+
+/**
+* \brief     .
+*
+* \return   ,    .
+*/
+keystreamStatistics keystreamCache::statistics() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
@@ -0,0 +1,67 @@
+#ifndef _KEYSTREAM_CACHE_H_
+#define _KEYSTREAM_CACHE_H_
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "gost12_15.h"
+
+/**
+* \brief      .
+*/
+struct keystreamStatistics {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t hitBytes;
+    uint64_t missBytes;
+    uint64_t generatedBytes;
+    uint64_t discardedBytes;
+};
+
+/**
+* \brief         .
+*
+*          .
+*   gammaCryption    ,    ,
+*      gammaCryptionBlocks    .
+*      (),      .
+*/
+class keystreamCache {
+public:
+    keystreamCache(const expandedKey& key, const vector<uint8_t>& sync, size_t capacity = 64 * 1024,
+                   uint64_t firstCounter = 1);
+    ~keystreamCache();
+
+    keystreamCache(const keystreamCache&) = delete;
+    keystreamCache& operator=(const keystreamCache&) = delete;
+
+    void gammaCryption(const uint8_t* in, uint8_t* out, size_t length);
+    vector<uint8_t> gammaCryption(const vector<uint8_t>& data);
+
+    size_t available();
+    keystreamStatistics statistics();
+private:
+    void producerLoop();
+    void generate(uint64_t offset, uint8_t* gamma, size_t length);
+    void xorFromRing(uint64_t offset, const uint8_t* in, uint8_t* out, size_t length);
+    void storeToRing(uint64_t offset, const uint8_t* gamma, size_t length);
+
+    expandedKey key;
+    uint8_t sync[8];
+    uint64_t firstCounter;
+
+    vector<uint8_t> ring;
+    uint64_t consumed = 0;
+    uint64_t produced = 0;
+
+    std::mutex mutex;
+    std::condition_variable spaceCondition;
+    bool stopping = false;
+    std::thread producer;
+
+    keystreamStatistics stats = {};
+};
+
+#endif
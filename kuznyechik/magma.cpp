@@ -0,0 +1,198 @@
+#include "magma.h"
+
+#include <cstring>
+
+#include "gostStatistics.h"
+#include "blockModes.h"
+
+
+const size_t magma::blockSize;
+
+
+/**
+* \brief :    .
+*
+*    j ( 8j..8j+7)   ,   pi[2j]  pi[2j+1].
+*   , g(x)     2    x.
+*/
+magma::magma() {
+    for (int j = 0; j < 4; j++) {
+        for (int b = 0; b < 256; b++) {
+            uint32_t s = static_cast<uint32_t>(pi[2 * j][b & 0x0f] | (pi[2 * j + 1][b >> 4] << 4)) << (8 * j);
+            gTable[j][b] = (s << 11) | (s >> 21);
+        }
+    }
+}
+
+
+/**
+* \brief   .
+*
+*     32-  K1..K8 (K1   4 ).  :
+* K1..K8 ,  K8..K1.
+*
+* \param [in] key    32 .
+* \param [out] expanded   .
+*/
+void magma::expandKey(const uint8_t* key, magmaKey& expanded) {
+    GOST_STAT_ADD(counterKeyExpansions, 1);
+
+    for (int i = 0; i < 24; i++) {
+        expanded.roundKeys[i] = magmaEngine::load32(key + 4 * (i % 8));
+    }
+    for (int i = 0; i < 8; i++) {
+        expanded.roundKeys[24 + i] = magmaEngine::load32(key + 4 * (7 - i));
+    }
+}
+
+
+/**
+* \brief     .
+*
+* \param [in] key   .
+* \param [in] in   .
+* \param [out] out    (   in).
+* \param [in] blockCount     8 .
+*/
+void magma::encryptBlocks(const magmaKey& key, const uint8_t* in, uint8_t* out, size_t blockCount) {
+    GOST_STAT_ADD(counterBlocksEncrypted, blockCount);
+
+    magmaEngine engine(*this);
+    withInterleave(interleave(blockCount * blockSize), [&](auto lanes) {
+        ecbEncrypt<decltype(lanes)::value>(engine, key, in, out, blockCount);
+    });
+}
+
+
+/**
+* \brief      (    ).
+*
+* \param [in] key   .
+* \param [in] in   .
+* \param [out] out    (   in).
+* \param [in] blockCount     8 .
+*/
+void magma::decryptBlocks(const magmaKey& key, const uint8_t* in, uint8_t* out, size_t blockCount) {
+    GOST_STAT_ADD(counterBlocksDecrypted, blockCount);
+
+    magmaEngine engine(*this);
+    magmaKey inverse;
+    engine.decryptKey(key, inverse);
+
+    withInterleave(interleave(blockCount * blockSize), [&](auto lanes) {
+        ecbDecrypt<decltype(lanes)::value>(engine, inverse, in, out, blockCount);
+    });
+
+    volatile uint32_t* p = inverse.roundKeys;
+    for (int i = 0; i < 32; i++) {
+        p[i] = 0;
+    }
+}
+
+
+/**
+* \brief     ( CTR    34.13-2015).
+*
+*     (4 )  32-     .
+*      0.
+*
+* \param [in] key   .
+* \param [in] sync    4 .
+* \param [in] firstCounter      .
+* \param [in] in   .
+* \param [out] out   (   in).
+* \param [in] length     .
+*/
+void magma::gammaCryptionBlocks(const magmaKey& key, const uint8_t* sync, uint32_t firstCounter,
+                                const uint8_t* in, uint8_t* out, size_t length) {
+    GOST_STAT_ADD(counterGammaBytes, length);
+    GOST_STAT_ADD(counterBlocksEncrypted, (length + blockSize - 1) / blockSize);
+    GOST_STAT_TIMER(operationGamma);
+
+    magmaEngine engine(*this);
+    withInterleave(interleave(length), [&](auto lanes) {
+        ctrCrypt<decltype(lanes)::value>(engine, key, sync, firstCounter, in, out, length);
+    });
+}
+
+
+/**
+* \brief      K1  K2 ( B64 = 0x1b, . magmaEngine).
+*
+* \param [in] key   .
+* \param [out] k1   K1  8 .
+* \param [out] k2   K2  8 .
+*/
+void magma::getImitoKeys(const magmaKey& key, uint8_t* k1, uint8_t* k2) {
+    GOST_STAT_ADD(counterBlocksEncrypted, 1);
+
+    cmacKeys(magmaEngine(*this), key, k1, k2);
+}
+
+
+/**
+* \brief      (  34.13-2015).
+*
+* \param [in] key   .
+* \param [in] data  .
+* \param [in] length     .
+* \param [out] imito  .
+* \param [in] imitoLength      (  8).
+*/
+void magma::imitoGenerationBlocks(const magmaKey& key, const uint8_t* data, size_t length,
+                                  uint8_t* imito, size_t imitoLength) {
+    GOST_STAT_ADD(counterImitoBytes, length);
+    GOST_STAT_TIMER(operationImito);
+
+    imitoCompute(key, data, length, imito, imitoLength);
+}
+
+
+/**
+* \brief     ,     .
+*
+* \param [in] key   .
+* \param [in] data  .
+* \param [in] length     .
+* \param [in] imito   .
+* \param [in] imitoLength      ( 1  8).
+* \return  true,   ; false    .
+*/
+bool magma::imitoVerify(const magmaKey& key, const uint8_t* data, size_t length,
+                        const uint8_t* imito, size_t imitoLength) {
+    if (imitoLength == 0 || imitoLength > blockSize) {
+        return false;
+    }
+
+    GOST_STAT_ADD(counterImitoVerifyBytes, length);
+    GOST_STAT_TIMER(operationImitoVerify);
+
+    uint8_t expected[blockSize];
+    imitoCompute(key, data, length, expected, imitoLength);
+
+    uint8_t difference = 0;
+    for (size_t i = 0; i < imitoLength; i++) {
+        difference |= expected[i] ^ imito[i];
+    }
+
+    return difference == 0;
+}
+
+
+void magma::imitoCompute(const magmaKey& key, const uint8_t* data, size_t length,
+                         uint8_t* imito, size_t imitoLength) {
+    GOST_STAT_ADD(counterBlocksEncrypted, (length == 0 ? 1 : (length + blockSize - 1) / blockSize) + 1);
+
+    cmacCompute(magmaEngine(*this), key, data, length, imito, imitoLength);
+}
+
+
+/**
+* \brief    ,     gost12_15.
+*
+* \param [in] length     .
+* \return   ,   .
+*/
+int magma::interleave(size_t length) {
+    return gost12_15::getInstance().getEngineChoice(tunedGamma, gost12_15::getSizeClass(length)).interleave;
+}
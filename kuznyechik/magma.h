@@ -0,0 +1,67 @@
+#ifndef _MAGMA_H_
+#define _MAGMA_H_
+
+#include "gost12_15.h"
+
+/**
+* \brief    : 32        .
+*/
+struct magmaKey {
+    uint32_t roundKeys[32];
+};
+
+/**
+* \brief    (  34.12-2015,  64 ,  256 ).
+*
+*   g    ,    
+*     11 .     ,
+*   gost12_15 (setEngineChoice, autotuner),     .
+* ,         ,     .
+*/
+class magma {
+    //  (blockEngines.h)     
+    friend struct magmaEngine;
+public:
+    static magma& getInstance() {
+        static magma m;
+        return m;
+    }
+
+    void expandKey(const uint8_t* key, magmaKey& expanded);
+    void encryptBlocks(const magmaKey& key, const uint8_t* in, uint8_t* out, size_t blockCount);
+    void decryptBlocks(const magmaKey& key, const uint8_t* in, uint8_t* out, size_t blockCount);
+    void gammaCryptionBlocks(const magmaKey& key, const uint8_t* sync, uint32_t firstCounter,
+                             const uint8_t* in, uint8_t* out, size_t length);
+    void imitoGenerationBlocks(const magmaKey& key, const uint8_t* data, size_t length,
+                               uint8_t* imito, size_t imitoLength);
+    bool imitoVerify(const magmaKey& key, const uint8_t* data, size_t length,
+                     const uint8_t* imito, size_t imitoLength);
+    void getImitoKeys(const magmaKey& key, uint8_t* k1, uint8_t* k2);
+
+    static const size_t blockSize = 8;
+private:
+    magma();
+    ~magma() {}
+
+    magma(const magma&) = delete;
+    magma& operator=(const magma&) = delete;
+
+    void imitoCompute(const magmaKey& key, const uint8_t* data, size_t length, uint8_t* imito, size_t imitoLength);
+    int interleave(size_t length);
+
+    //  : gTable[j][b]    b   j      11
+    alignas(64) uint32_t gTable[4][256];
+
+    const uint8_t pi[8][16] = {
+        { 12, 4, 6, 2, 10, 5, 11, 9, 14, 8, 13, 7, 0, 3, 15, 1 },
+        { 6, 8, 2, 3, 9, 10, 5, 12, 1, 14, 4, 7, 11, 13, 0, 15 },
+        { 11, 3, 5, 8, 2, 15, 10, 13, 14, 1, 7, 4, 12, 9, 6, 0 },
+        { 12, 8, 2, 1, 13, 4, 15, 6, 7, 0, 10, 5, 3, 14, 9, 11 },
+        { 7, 15, 5, 10, 8, 1, 6, 13, 0, 9, 3, 14, 11, 4, 2, 12 },
+        { 5, 13, 15, 6, 9, 2, 12, 10, 11, 7, 8, 1, 4, 3, 14, 0 },
+        { 8, 14, 2, 5, 6, 9, 1, 12, 15, 4, 11, 0, 13, 10, 3, 7 },
+        { 1, 7, 14, 13, 0, 5, 8, 3, 4, 15, 10, 6, 9, 12, 11, 2 }
+    };
+};
+
+#endif
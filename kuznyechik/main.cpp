@@ -1,6 +1,21 @@
 #include <iostream>
+#include <algorithm>
 
 #include "gost12_15.h"
+#include "cryptoDaemon.h"
+#include "keystreamCache.h"
+#include "benchmark.h"
+#include "gostStatistics.h"
+#include "autotuner.h"
+#include "ctrDrbg.h"
+#include "randomnessTests.h"
+#include "magma.h"
+#include "blockCipher.h"
+#include "asyncStream.h"
+#include "segmentedContainer.h"
+
+#include <cstdio>
+#include <fstream>
 
 using std::string;
 
@@ -10,9 +25,22 @@ void XTransformationExample();
 
 void encryptDecryptExample(vector<vector<uint8_t>> roundKeys);
 void gammaCryptionExample(vector<vector<uint8_t>> roundKeys);
+void gammaCryptionBatchExample(vector<vector<uint8_t>> roundKeys);
 
 void imitoGenerationExample(vector<vector<uint8_t>> roundKeys);
 
+void cryptoDaemonExample(vector<uint8_t> key, vector<vector<uint8_t>> roundKeys);
+void keystreamCacheExample(vector<vector<uint8_t>> roundKeys);
+void statisticsExample();
+void autotunerExample();
+void ctrDrbgExample();
+void magmaExample();
+void blockCipherExample();
+void containerExample();
+#if defined(__cpp_impl_coroutine)
+void asyncStreamExample();
+#endif
+
 int main() {
     gost12_15 &g = gost12_15::getInstance();
 
@@ -24,6 +52,7 @@ int main() {
     };
 
     g.initRoundConsts();
+    autotunerExample();
     vector<vector<uint8_t>> roundKeys = g.generatingRoundKeys(generalKey);
 
     LTransformationExample();
@@ -32,8 +61,30 @@ int main() {
 
     encryptDecryptExample(roundKeys);
     gammaCryptionExample(roundKeys);
+    gammaCryptionBatchExample(roundKeys);
 
     imitoGenerationExample(roundKeys);
+    magmaExample();
+    blockCipherExample();
+    containerExample();
+#if defined(__cpp_impl_coroutine)
+    asyncStreamExample();
+#else
+    cout << "Async stream encryption skipped: asyncStream requires C++20 coroutines" << endl;
+#endif
+
+    cryptoDaemonExample(generalKey, roundKeys);
+    keystreamCacheExample(roundKeys);
+    ctrDrbgExample();
+    statisticsExample();
+
+    keyScheduleBenchmark();
+    compactTableBenchmark();
+    jobSchedulerBenchmark();
+    magmaBenchmark();
+    containerBenchmark();
+    bufferPoolBenchmark();
+    kdfBenchmark();
 
     system("pause");
 }
@@ -253,6 +304,50 @@ void gammaCryptionExample(vector<vector<uint8_t>> roundKeys) {
 }
 
 
+/**
+* \brief         .
+*
+* \param [in] roundKeys -   .
+*/
+void gammaCryptionBatchExample(vector<vector<uint8_t>> roundKeys) {
+    cout << "Testing gamma cryption batch" << endl;
+    cout << "----------------------------" << endl;
+
+    gost12_15 &g = gost12_15::getInstance();
+    expandedKey key = g.packRoundKeys(roundKeys);
+
+    //             .
+    const size_t lengths[] = { 64, 0, 1, 15, 16, 17, 31, 80, 100, 129, 255, 0 };
+    const int packetCount = 36;
+    vector<vector<uint8_t>> packets(packetCount);
+    vector<vector<uint8_t>> syncs(packetCount);
+    vector<packetDescriptor> descriptors(packetCount);
+
+    for (int i = 0; i < packetCount; i++) {
+        packets[i].assign(lengths[i % (sizeof(lengths) / sizeof(lengths[0]))], static_cast<uint8_t>(i));
+        syncs[i].assign(8, static_cast<uint8_t>(0xa0 + i));
+        descriptors[i].sync = syncs[i].data();
+        descriptors[i].data = packets[i].data();
+        descriptors[i].length = packets[i].size();
+    }
+
+    g.gammaCryptionBatch(key, descriptors.data(), descriptors.size());
+
+    int mismatches = 0;
+    for (int i = 0; i < packetCount; i++) {
+        vector<uint8_t> data(packets[i].size(), static_cast<uint8_t>(i));
+        vector<uint8_t> expected(data.size(), 0);
+        g.gammaCryptionBlocks(key, syncs[i].data(), 1, data.data(), expected.data(), data.size());
+        if (expected != packets[i]) {
+            mismatches++;
+        }
+    }
+
+    cout << std::dec << "Packets: " << packetCount << ", mismatches: " << mismatches << endl;
+    cout << "------------------------" << endl;
+}
+
+
 /**
 * \brief     .
 *
@@ -295,3 +390,544 @@ void imitoGenerationExample(vector<vector<uint8_t>> roundKeys) {
     cout << endl;
     cout << "------------------------" << endl;
 }
+
+
+/**
+* \brief        Unix domain socket.
+*
+*      ,     .
+*    gammaCryption  imitoGeneration.
+*
+* \param [in] key -  .
+* \param [in] roundKeys -   .
+*/
+void cryptoDaemonExample(vector<uint8_t> key, vector<vector<uint8_t>> roundKeys) {
+    cout << "Testing crypto daemon" << endl;
+    cout << "------------------------" << endl;
+
+    gost12_15 &g = gost12_15::getInstance();
+
+    const string socketPath = "kuznyechik_daemon.sock";
+    cryptoDaemon daemon;
+    if (!daemon.listen(socketPath)) {
+        cout << "Daemon: failed to listen on " << socketPath << endl;
+        cout << "------------------------" << endl;
+        return;
+    }
+
+    const int clientCount = 4;
+    const int requestCount = 100;
+    std::atomic<int> mismatches(0);
+    vector<std::thread> clients;
+
+    for (int c = 0; c < clientCount; c++) {
+        clients.push_back(std::thread([&, c]() {
+            cryptoDaemonClient client;
+            uint32_t keyId = 0;
+            if (!client.connect(socketPath) || !client.loadKey(key, keyId)) {
+                mismatches++;
+                return;
+            }
+
+            for (int i = 0; i < requestCount; i++) {
+                vector<uint8_t> data(64, static_cast<uint8_t>(c * requestCount + i));
+                vector<uint8_t> sync(8, static_cast<uint8_t>(i));
+                vector<uint8_t> enc;
+                vector<uint8_t> imito;
+
+                if (!client.gammaCryption(keyId, sync, data, enc) || enc != g.gammaCryption(data, sync, roundKeys)) {
+                    mismatches++;
+                }
+                if (!client.imitoGeneration(keyId, data, imito) || imito != g.imitoGeneration(data, roundKeys)) {
+                    mismatches++;
+                }
+            }
+            client.unloadKey(keyId);
+        }));
+    }
+
+    for (size_t i = 0; i < clients.size(); i++) {
+        clients[i].join();
+    }
+
+    cryptoDaemonClient owner;
+    cryptoDaemonClient stranger;
+    uint32_t ownedKeyId = 0;
+    vector<uint8_t> foreign;
+    bool isolated = owner.connect(socketPath) && stranger.connect(socketPath) && owner.loadKey(key, ownedKeyId)
+        && !stranger.gammaCryption(ownedKeyId, vector<uint8_t>(8, 0), vector<uint8_t>(16, 0), foreign)
+        && !stranger.unloadKey(ownedKeyId) && owner.unloadKey(ownedKeyId);
+
+    daemonStatistics stats = daemon.statistics();
+    cout << std::dec;
+    cout << "Mismatches: " << mismatches << endl;
+    cout << "Keys isolated between connections: " << (isolated ? "yes" : "no") << endl;
+    cout << "Requests: " << stats.requests << ", batches: " << stats.batches
+         << ", max batch: " << stats.maxBatchRequests << endl;
+    cout << "Blocks: " << stats.blocks << ", bytes: " << stats.bytes << endl;
+    cout << "Average latency, us: " << (stats.requests ? stats.totalLatencyNs / stats.requests / 1000 : 0)
+         << ", max latency, us: " << stats.maxLatencyNs / 1000 << endl;
+
+    daemon.stop();
+    cout << "------------------------" << endl;
+}
+
+
+/**
+* \brief         .
+*
+*    keystreamCache      .
+*
+* \param [in] roundKeys -   .
+*/
+void keystreamCacheExample(vector<vector<uint8_t>> roundKeys) {
+    cout << "Testing keystream cache" << endl;
+    cout << "------------------------" << endl;
+
+    gost12_15 &g = gost12_15::getInstance();
+    expandedKey key = g.packRoundKeys(roundKeys);
+
+    vector<uint8_t> sync = {
+        0x64, 0xa5, 0x94, 0x78, 0xa1, 0x41, 0xf2, 0x5e
+    };
+
+    keystreamCache cache(key, sync, 16 * 1024);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    vector<uint8_t> stream;
+    vector<uint8_t> encStream;
+    for (int i = 0; i < 200; i++) {
+        vector<uint8_t> packet(40 + i % 90, static_cast<uint8_t>(i));
+        vector<uint8_t> encPacket = cache.gammaCryption(packet);
+        stream.insert(stream.end(), packet.begin(), packet.end());
+        encStream.insert(encStream.end(), encPacket.begin(), encPacket.end());
+    }
+
+    vector<uint8_t> check(stream.size(), 0);
+    g.gammaCryptionBlocks(key, sync.data(), 1, stream.data(), check.data(), stream.size());
+
+    keystreamStatistics stats = cache.statistics();
+    cout << std::dec;
+    cout << "Matches gammaCryptionBlocks: " << (check == encStream ? "yes" : "no") << endl;
+    cout << "Hits: " << stats.hits << ", misses: " << stats.misses << endl;
+    cout << "Hit bytes: " << stats.hitBytes << ", miss bytes: " << stats.missBytes
+         << ", generated bytes: " << stats.generatedBytes << endl;
+    cout << "------------------------" << endl;
+}
+
+
+/**
+* \brief     ,   .
+*
+*  ,      GOST12_15_STATISTICS.
+*/
+void statisticsExample() {
+    cout << "Cipher statistics" << endl;
+    cout << "------------------------" << endl;
+
+    statisticsSnapshot snapshot = gostStatistics::getInstance().snapshot();
+    cout << std::dec << gostStatistics::format(snapshot);
+
+    cout << "------------------------" << endl;
+}
+
+
+/**
+* \brief     .
+*
+*           gost12_15.tune,
+*           .
+*   GOST12_15_ENGINE (, "table:4")   .
+*/
+void autotunerExample() {
+    cout << "Autotuner" << endl;
+    cout << "------------------------" << endl;
+
+    autotuner &a = autotuner::getInstance();
+    bool cached = a.tune("gost12_15.tune");
+
+    cout << "CPU: " << autotuner::cpuSignature() << endl;
+    cout << (cached ? "Tuning skipped (cache file or GOST12_15_ENGINE)" : "Configuration tuned and saved") << endl;
+    cout << autotuner::describe();
+#ifdef GOST12_15_COMPACT_ENGINE
+    cout << "Engine fixed at build time: compact (GOST12_15_COMPACT_ENGINE)" << endl;
+#endif
+
+    cout << "------------------------" << endl;
+}
+
+
+/**
+* \brief      CTR_DRBG     .
+*/
+void ctrDrbgExample() {
+    cout << "CTR_DRBG" << endl;
+    cout << "------------------------" << endl;
+
+    vector<uint8_t> nonce(16);
+    threadRandom::bytes(nonce);
+    cout << "Nonce: ";
+    for (size_t i = 0; i < nonce.size(); i++) {
+        cout << "0x" << std::hex << (int)nonce[i] << " ";
+    }
+    cout << endl;
+
+    vector<uint8_t> sample(1024 * 1024);
+    for (size_t i = 0; i < sample.size(); i += 32) {
+        threadRandom::bytes(&sample[i], 32);
+    }
+
+    vector<randomTestResult> results = randomnessTests(sample.data(), sample.size());
+    cout << std::dec;
+    for (size_t i = 0; i < results.size(); i++) {
+        cout << results[i].name << ": p = " << results[i].pValue << (results[i].passed ? ", passed" : ", FAILED") << endl;
+    }
+
+    cout << "------------------------" << endl;
+}
+
+
+/**
+* \brief       (    34.13-2015).
+*/
+void magmaExample() {
+    cout << "Magma" << endl;
+    cout << "------------------------" << endl;
+
+    magma &m = magma::getInstance();
+
+    vector<uint8_t> key = {
+        0xff, 0xee, 0xdd, 0xcc, 0xbb, 0xaa, 0x99, 0x88,
+        0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00,
+        0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+        0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff
+    };
+
+    vector<uint8_t> data = {
+        0x92, 0xde, 0xf0, 0x6b, 0x3c, 0x13, 0x0a, 0x59,
+        0xdb, 0x54, 0xc7, 0x04, 0xf8, 0x18, 0x9d, 0x20,
+        0x4a, 0x98, 0xfb, 0x2e, 0x67, 0xa8, 0x02, 0x4c,
+        0x89, 0x12, 0x40, 0x9b, 0x17, 0xb5, 0x7e, 0x41
+    };
+
+    uint8_t sync[4] = { 0x12, 0x34, 0x56, 0x78 };
+
+    magmaKey expanded;
+    m.expandKey(key.data(), expanded);
+
+    vector<uint8_t> encrypted(data.size());
+    m.encryptBlocks(expanded, data.data(), encrypted.data(), data.size() / magma::blockSize);
+    cout << "ECB: ";
+    for (size_t i = 0; i < encrypted.size(); i++) {
+        cout << "0x" << std::hex << (int)encrypted[i] << " ";
+    }
+    cout << endl;
+
+    vector<uint8_t> gamma(data.size());
+    m.gammaCryptionBlocks(expanded, sync, 0, data.data(), gamma.data(), data.size());
+    cout << "CTR: ";
+    for (size_t i = 0; i < gamma.size(); i++) {
+        cout << "0x" << std::hex << (int)gamma[i] << " ";
+    }
+    cout << endl;
+
+    uint8_t imito[4];
+    m.imitoGenerationBlocks(expanded, data.data(), data.size(), imito, sizeof(imito));
+    cout << "Imito: ";
+    for (size_t i = 0; i < sizeof(imito); i++) {
+        cout << "0x" << std::hex << (int)imito[i] << " ";
+    }
+    cout << endl;
+    cout << "Imito verified: " << (m.imitoVerify(expanded, data.data(), data.size(), imito, sizeof(imito)) ? "yes" : "no") << endl;
+
+    cout << "------------------------" << endl;
+}
+
+
+/**
+* \brief      CBC  blockCipher   .
+*/
+void blockCipherExample() {
+    cout << "Block cipher modes" << endl;
+    cout << "------------------------" << endl;
+
+    vector<uint8_t> key(32);
+    for (size_t i = 0; i < key.size(); i++) {
+        key[i] = static_cast<uint8_t>(i);
+    }
+
+    vector<uint8_t> data(64);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(0xa0 + i);
+    }
+
+    const cipherAlgorithm algorithms[] = { algorithmKuznyechik, algorithmMagma };
+    const char* names[] = { "Kuznyechik", "Magma" };
+
+    for (int a = 0; a < 2; a++) {
+        blockCipher cipher(algorithms[a], key.data());
+        size_t blocks = data.size() / cipher.getBlockSize();
+
+        vector<uint8_t> iv(cipher.getBlockSize(), 0x5c);
+        vector<uint8_t> encrypted(data.size());
+        cipher.cbcEncrypt(iv.data(), data.data(), encrypted.data(), blocks);
+
+        cout << names[a] << " CBC: ";
+        for (size_t i = 0; i < encrypted.size(); i++) {
+            cout << "0x" << std::hex << (int)encrypted[i] << " ";
+        }
+        cout << endl;
+
+        std::fill(iv.begin(), iv.end(), 0x5c);
+        vector<uint8_t> decrypted(encrypted);
+        cipher.cbcDecrypt(iv.data(), decrypted.data(), decrypted.data(), blocks);
+        cout << names[a] << " CBC decrypted correctly: " << (decrypted == data ? "yes" : "no") << endl;
+    }
+
+    cout << "------------------------" << endl;
+}
+
+
+/**
+* \brief       .
+*
+*       (    )  
+*  ,    :  ,  ,
+* ,     .
+*/
+void containerExample() {
+    cout << "Segmented container" << endl;
+    cout << "------------------------" << endl;
+
+    vector<uint8_t> key(32);
+    for (size_t i = 0; i < key.size(); i++) {
+        key[i] = static_cast<uint8_t>(0x20 + 3 * i);
+    }
+    vector<uint8_t> wrongKey(key);
+    wrongKey[0] ^= 1;
+
+    const cipherAlgorithm algorithms[] = { algorithmKuznyechik, algorithmMagma };
+    const char* names[] = { "Kuznyechik", "Magma" };
+    const uint32_t segmentSizes[] = { 16, 48, 4096, 64 * 1024 };
+    const size_t lengths[] = { 0, 1, 15, 16, 47, 4096, 4097, 100000, 300001 };
+    const string path = "segmentedContainerExample.bin";
+
+    for (int a = 0; a < 2; a++) {
+        size_t containers = 0;
+        size_t openErrors = 0;
+        size_t readErrors = 0;
+        size_t fileErrors = 0;
+        size_t undetected = 0;
+        uint32_t random = 0x9e3779b9;
+
+        for (uint32_t segmentSize : segmentSizes) {
+            const size_t tagLength = algorithms[a] == algorithmMagma ? 8 : 16;
+            segmentedContainer container(algorithms[a], key.data(), segmentSize, tagLength, 3);
+            segmentedContainer stranger(algorithms[a], wrongKey.data(), segmentSize, tagLength, 3);
+
+            for (size_t length : lengths) {
+                vector<uint8_t> data(length);
+                for (size_t i = 0; i < length; i++) {
+                    data[i] = static_cast<uint8_t>(i * 13 + length + segmentSize);
+                }
+
+                vector<uint8_t> sealed;
+                vector<uint8_t> opened;
+                if (!container.seal(data.data(), length, sealed)) {
+                    openErrors++;
+                    continue;
+                }
+                containers++;
+                if (!container.open(sealed.data(), sealed.size(), opened) || opened != data) {
+                    openErrors++;
+                }
+
+                for (int k = 0; k < 8 && length > 0; k++) {
+                    random = random * 1103515245 + 12345;
+                    size_t offset = random % length;
+                    random = random * 1103515245 + 12345;
+                    size_t part = random % (length - offset + 1);
+                    vector<uint8_t> out(part);
+                    if (!container.read(sealed.data(), sealed.size(), offset, out.data(), part) ||
+                        !std::equal(out.begin(), out.end(), data.begin() + offset)) {
+                        readErrors++;
+                    }
+                }
+
+                if (length > 1000) {
+                    {
+                        std::ofstream file(path, std::ios::binary);
+                        file.write(reinterpret_cast<const char*>(sealed.data()), sealed.size());
+                    }
+                    size_t offset = length / 3;
+                    vector<uint8_t> out(length / 4);
+                    if (!container.readFile(path, offset, out.data(), out.size()) ||
+                        !std::equal(out.begin(), out.end(), data.begin() + offset)) {
+                        fileErrors++;
+                    }
+                    std::remove(path.c_str());
+                }
+
+                vector<uint8_t> tampered(sealed);
+                tampered[tampered.size() / 2] ^= 0x01;
+                if (container.open(tampered.data(), tampered.size(), opened)) {
+                    undetected++;
+                }
+
+                if (length >= 2 * static_cast<size_t>(segmentSize)) {
+                    size_t first = segmentedContainer::fixedHeaderSize + tagLength;
+                    size_t stride = segmentSize + tagLength;
+                    tampered = sealed;
+                    std::swap_ranges(tampered.begin() + first, tampered.begin() + first + stride,
+                                     tampered.begin() + first + stride);
+                    vector<uint8_t> out(segmentSize);
+                    if (container.read(tampered.data(), tampered.size(), 0, out.data(), out.size()) ||
+                        container.open(tampered.data(), tampered.size(), opened)) {
+                        undetected++;
+                    }
+                }
+
+                if (length > segmentSize) {
+                    tampered.assign(sealed.begin(), sealed.end() - segmentSize - tagLength);
+                    if (container.open(tampered.data(), tampered.size(), opened)) {
+                        undetected++;
+                    }
+                }
+                tampered.assign(sealed.begin(), sealed.end() - 1);
+                if (container.open(tampered.data(), tampered.size(), opened)) {
+                    undetected++;
+                }
+
+                tampered = sealed;
+                tampered[segmentedContainer::fixedHeaderSize - 1] ^= 0x80;
+                if (container.open(tampered.data(), tampered.size(), opened)) {
+                    undetected++;
+                }
+
+                if (stranger.open(sealed.data(), sealed.size(), opened)) {
+                    undetected++;
+                }
+            }
+        }
+
+        cout << names[a] << " containers sealed: " << std::dec << containers << endl;
+        cout << names[a] << " opened correctly: " << (openErrors == 0 ? "yes" : "no") << endl;
+        cout << names[a] << " random reads match data: " << (readErrors == 0 ? "yes" : "no") << endl;
+        cout << names[a] << " file reads match data: " << (fileErrors == 0 ? "yes" : "no") << endl;
+        cout << names[a] << " modifications detected: " << (undetected == 0 ? "yes" : "no") << endl;
+    }
+
+    cout << "------------------------" << endl;
+}
+
+
+#if defined(__cpp_impl_coroutine)
+/**
+* \brief ,          .
+*
+* \param [in] pipe  .
+* \param [in] data  .
+*/
+asyncTask<void> produceExampleData(memoryPipe& pipe, const vector<uint8_t>& data) {
+    for (size_t offset = 0, part = 1; offset < data.size(); part = part * 3 % 4999 + 1) {
+        size_t length = std::min(part, data.size() - offset);
+        co_await pipe.write(data.data() + offset, length);
+        offset += length;
+    }
+    pipe.close();
+}
+
+
+/**
+* \brief ,     .
+*
+* \param [in] pipe  .
+* \param [out] data   .
+*/
+asyncTask<void> consumeExampleData(memoryPipe& pipe, vector<uint8_t>& data) {
+    uint8_t buffer[1500];
+    while (size_t length = co_await pipe.read(buffer, sizeof(buffer))) {
+        data.insert(data.end(), buffer, buffer + length);
+    }
+}
+
+
+/**
+* \brief ,        .
+*
+* \param [in] operation  .
+* \param [in] pipe   .
+* \param [out] result   .
+*/
+template <class T>
+asyncTask<void> finishExampleStream(asyncTask<T> operation, memoryPipe& pipe, T& result) {
+    result = co_await operation;
+    pipe.close();
+}
+
+
+/**
+* \brief       .
+*
+*         :   ,  
+*          .
+*/
+void asyncStreamExample() {
+    cout << "Async stream encryption" << endl;
+    cout << "------------------------" << endl;
+
+    vector<uint8_t> key(32);
+    for (size_t i = 0; i < key.size(); i++) {
+        key[i] = static_cast<uint8_t>(0x40 + i);
+    }
+    const uint8_t sync[8] = { 0x12, 0x34, 0x56, 0x78, 0x90, 0xab, 0xcd, 0xef };
+
+    vector<uint8_t> data(1024 * 1024);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+
+    blockCipher cipher(algorithmKuznyechik, key.data());
+    eventLoop loop;
+    cipherWorkers workers(2);
+    asyncStreamOptions options;
+    options.chunkSize = 16 * 1024;
+    options.maxInFlight = 4;
+    asyncStreamCipher stream(loop, workers, cipher, options);
+
+    memoryPipe plainPipe(loop, 8 * 1024);
+    memoryPipe cipherPipe(loop, 8 * 1024);
+    vector<uint8_t> encrypted;
+    uint8_t imito[16];
+    uint64_t total = 0;
+
+    loop.spawn(produceExampleData(plainPipe, data));
+    loop.spawn(finishExampleStream(stream.encrypt(plainPipe, cipherPipe, sync, imito, sizeof(imito)), cipherPipe, total));
+    loop.runUntilComplete(consumeExampleData(cipherPipe, encrypted));
+
+    vector<uint8_t> expected(data.size());
+    uint8_t expectedImito[16];
+    cipher.ctrCrypt(sync, 1, data.data(), expected.data(), data.size());
+    cipher.imito(expected.data(), expected.size(), expectedImito, sizeof(expectedImito));
+
+    cout << "Encrypted bytes: " << std::dec << total << endl;
+    cout << "Matches ctrCrypt and imito: "
+         << (encrypted == expected && memcmp(imito, expectedImito, sizeof(imito)) == 0 ? "yes" : "no") << endl;
+    cout << "Peak pipe fill (bytes): " << plainPipe.getPeakFill() << " / " << cipherPipe.getPeakFill() << endl;
+
+    memoryPipe encryptedPipe(loop, 8 * 1024);
+    memoryPipe decryptedPipe(loop, 8 * 1024);
+    vector<uint8_t> decrypted;
+    bool verified = false;
+
+    loop.spawn(produceExampleData(encryptedPipe, encrypted));
+    loop.spawn(finishExampleStream(stream.decrypt(encryptedPipe, decryptedPipe, sync, imito, sizeof(imito)),
+                                   decryptedPipe, verified));
+    loop.runUntilComplete(consumeExampleData(decryptedPipe, decrypted));
+
+    cout << "Imito verified: " << (verified ? "yes" : "no") << endl;
+    cout << "Decrypted correctly: " << (decrypted == data ? "yes" : "no") << endl;
+
+    cout << "------------------------" << endl;
+}
+#endif
@@ -0,0 +1,267 @@
+#include "randomnessTests.h"
+
+#include <cmath>
+
+
+namespace {
+
+/**
+* \brief      - Q(a, x).
+*/
+double igamc(double a, double x) {
+    if (x <= 0) {
+        return 1;
+    }
+
+    const double epsilon = 1e-15;
+    double logPrefix = a * log(x) - x - lgamma(a);
+
+    if (x < a + 1) {
+        double term = 1 / a;
+        double sum = term;
+        for (int n = 1; n < 10000; n++) {
+            term *= x / (a + n);
+            sum += term;
+            if (term < sum * epsilon) {
+                break;
+            }
+        }
+        return 1 - sum * exp(logPrefix);
+    }
+
+    double tiny = 1e-300;
+    double b = x + 1 - a;
+    double c = 1 / tiny;
+    double d = 1 / b;
+    double h = d;
+    for (int n = 1; n < 10000; n++) {
+        double an = -n * (n - a);
+        b += 2;
+        d = an * d + b;
+        d = fabs(d) < tiny ? tiny : d;
+        c = b + an / c;
+        c = fabs(c) < tiny ? tiny : c;
+        d = 1 / d;
+        double delta = d * c;
+        h *= delta;
+        if (fabs(delta - 1) < epsilon) {
+            break;
+        }
+    }
+    return exp(logPrefix) * h;
+}
+
+
+double normalCdf(double x) {
+    return 0.5 * erfc(-x / sqrt(2.0));
+}
+
+
+inline int bit(const uint8_t* data, size_t i) {
+    return (data[i / 8] >> (7 - i % 8)) & 1;
+}
+
+
+randomTestResult result(const char* name, double pValue) {
+    randomTestResult r = { name, pValue, pValue >= randomTestSignificance };
+    return r;
+}
+
+
+/**
+* \brief   (    ).
+*/
+randomTestResult monobitTest(const uint8_t* data, size_t n) {
+    double sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum += 2 * bit(data, i) - 1;
+    }
+    return result("monobit", erfc(fabs(sum) / sqrt(static_cast<double>(n)) / sqrt(2.0)));
+}
+
+
+/**
+* \brief      128 .
+*/
+randomTestResult blockFrequencyTest(const uint8_t* data, size_t n) {
+    const size_t m = 128;
+    size_t blocks = n / m;
+    double chiSquare = 0;
+
+    for (size_t b = 0; b < blocks; b++) {
+        int ones = 0;
+        for (size_t i = 0; i < m; i++) {
+            ones += bit(data, b * m + i);
+        }
+        double pi = static_cast<double>(ones) / m - 0.5;
+        chiSquare += pi * pi;
+    }
+    chiSquare *= 4.0 * m;
+
+    return result("block_frequency", igamc(blocks / 2.0, chiSquare / 2));
+}
+
+
+/**
+* \brief   (    ).
+*/
+randomTestResult runsTest(const uint8_t* data, size_t n) {
+    double ones = 0;
+    for (size_t i = 0; i < n; i++) {
+        ones += bit(data, i);
+    }
+
+    double pi = ones / n;
+    if (fabs(pi - 0.5) >= 2 / sqrt(static_cast<double>(n))) {
+        return result("runs", 0);
+    }
+
+    double runs = 1;
+    for (size_t i = 1; i < n; i++) {
+        runs += bit(data, i) != bit(data, i - 1);
+    }
+
+    double expected = 2 * n * pi * (1 - pi);
+    return result("runs", erfc(fabs(runs - expected) / (2 * sqrt(2.0 * n) * pi * (1 - pi))));
+}
+
+
+/**
+* \brief        128 .
+*/
+randomTestResult longestRunTest(const uint8_t* data, size_t n) {
+    const size_t m = 128;
+    const int categories = 6;
+    const double probabilities[categories] = { 0.1174, 0.2430, 0.2493, 0.1752, 0.1027, 0.1124 };
+    size_t blocks = n / m;
+    double counts[categories] = { 0 };
+
+    for (size_t b = 0; b < blocks; b++) {
+        int longest = 0;
+        int run = 0;
+        for (size_t i = 0; i < m; i++) {
+            run = bit(data, b * m + i) ? run + 1 : 0;
+            longest = run > longest ? run : longest;
+        }
+
+        int category = longest <= 4 ? 0 : longest >= 9 ? 5 : longest - 4;
+        counts[category]++;
+    }
+
+    double chiSquare = 0;
+    for (int i = 0; i < categories; i++) {
+        double expected = blocks * probabilities[i];
+        chiSquare += (counts[i] - expected) * (counts[i] - expected) / expected;
+    }
+
+    return result("longest_run", igamc((categories - 1) / 2.0, chiSquare / 2));
+}
+
+
+/**
+* \brief    ( ).
+*/
+randomTestResult cumulativeSumsTest(const uint8_t* data, size_t n) {
+    long long sum = 0;
+    long long maximum = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum += 2 * bit(data, i) - 1;
+        maximum = llabs(sum) > maximum ? llabs(sum) : maximum;
+    }
+
+    double z = static_cast<double>(maximum);
+    double root = sqrt(static_cast<double>(n));
+    double p = 1;
+    for (long long k = static_cast<long long>(floor((-(n / z) + 1) / 4)); k <= static_cast<long long>(floor((n / z - 1) / 4)); k++) {
+        p -= normalCdf((4 * k + 1) * z / root) - normalCdf((4 * k - 1) * z / root);
+    }
+    for (long long k = static_cast<long long>(floor((-(n / z) - 3) / 4)); k <= static_cast<long long>(floor((n / z - 1) / 4)); k++) {
+        p += normalCdf((4 * k + 3) * z / root) - normalCdf((4 * k + 1) * z / root);
+    }
+
+    return result("cumulative_sums", p);
+}
+
+
+/**
+* \brief       8 .
+*/
+randomTestResult approximateEntropyTest(const uint8_t* data, size_t n) {
+    const int m = 8;
+    double phi[2];
+
+    for (int t = 0; t < 2; t++) {
+        int length = m + t;
+        std::vector<double> counts(static_cast<size_t>(1) << length, 0);
+        unsigned pattern = 0;
+        for (int i = 0; i < length - 1; i++) {
+            pattern = (pattern << 1) | bit(data, i);
+        }
+        for (size_t i = 0; i < n; i++) {
+            pattern = ((pattern << 1) | bit(data, (i + length - 1) % n)) & ((1u << length) - 1);
+            counts[pattern]++;
+        }
+
+        phi[t] = 0;
+        for (size_t i = 0; i < counts.size(); i++) {
+            if (counts[i] > 0) {
+                double c = counts[i] / n;
+                phi[t] += c * log(c);
+            }
+        }
+    }
+
+    double chiSquare = 2.0 * n * (log(2.0) - (phi[0] - phi[1]));
+    return result("approximate_entropy", igamc(pow(2.0, m - 1), chiSquare / 2));
+}
+
+
+/**
+* \brief  -   .
+*/
+randomTestResult byteDistributionTest(const uint8_t* data, size_t length) {
+    double counts[256] = { 0 };
+    for (size_t i = 0; i < length; i++) {
+        counts[data[i]]++;
+    }
+
+    double expected = length / 256.0;
+    double chiSquare = 0;
+    for (int i = 0; i < 256; i++) {
+        chiSquare += (counts[i] - expected) * (counts[i] - expected) / expected;
+    }
+
+    return result("byte_distribution", igamc(255 / 2.0, chiSquare / 2));
+}
+
+}
+
+
+/**
+* \brief      .
+*
+*   NIST SP 800-22: ,   , ,   ,
+*  ,  ,    -  .
+*     p-   randomTestSignificance.
+*       100  .
+*
+* \param [in] data   .
+* \param [in] length     .
+* \return    ( ,    1 ).
+*/
+std::vector<randomTestResult> randomnessTests(const uint8_t* data, size_t length) {
+    std::vector<randomTestResult> results;
+    if (length < 1024) {
+        return results;
+    }
+
+    size_t n = length * 8;
+    results.push_back(monobitTest(data, n));
+    results.push_back(blockFrequencyTest(data, n));
+    results.push_back(runsTest(data, n));
+    results.push_back(longestRunTest(data, n));
+    results.push_back(cumulativeSumsTest(data, n));
+    results.push_back(approximateEntropyTest(data, n));
+    results.push_back(byteDistributionTest(data, length));
+    return results;
+}
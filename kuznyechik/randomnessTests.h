@@ -0,0 +1,22 @@
+#ifndef _RANDOMNESS_TESTS_H_
+#define _RANDOMNESS_TESTS_H_
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+* \brief    .
+*/
+struct randomTestResult {
+    std::string name;
+    double pValue;
+    bool passed;
+};
+
+const double randomTestSignificance = 0.01;
+
+std::vector<randomTestResult> randomnessTests(const uint8_t* data, size_t length);
+
+#endif
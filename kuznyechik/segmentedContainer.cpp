@@ -0,0 +1,555 @@
+#include "segmentedContainer.h"
+
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <fstream>
+
+#include "ctrDrbg.h"
+#include "bufferPool.h"
+
+
+namespace {
+
+const uint8_t containerMagic[8] = { 'G', 'O', 'S', 'T', 'S', 'E', 'G', '1' };
+const uint8_t containerVersion = 1;
+
+
+void store32(uint8_t* data, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        data[i] = static_cast<uint8_t>(value >> (24 - 8 * i));
+    }
+}
+
+
+void store64(uint8_t* data, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        data[i] = static_cast<uint8_t>(value >> (56 - 8 * i));
+    }
+}
+
+
+uint64_t load64(const uint8_t* data) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value = (value << 8) | data[i];
+    }
+    return value;
+}
+
+
+void wipe(uint8_t* data, size_t length) {
+    volatile uint8_t* p = data;
+    for (size_t i = 0; i < length; i++) {
+        p[i] = 0;
+    }
+}
+
+
+bool tagsEqual(const uint8_t* a, const uint8_t* b, size_t length) {
+    uint8_t difference = 0;
+    for (size_t i = 0; i < length; i++) {
+        difference |= a[i] ^ b[i];
+    }
+    return difference == 0;
+}
+
+
+size_t blockSizeOf(cipherAlgorithm algorithm) {
+    return algorithm == algorithmMagma ? magmaEngine::blockSize : kuznyechikEngineBase::blockSize;
+}
+
+
+uint64_t segmentLength(const containerHeader& header, uint64_t index) {
+    uint64_t count = segmentedContainer::segmentCount(header);
+    return index + 1 < count ? header.segmentSize : header.dataLength - (count - 1) * header.segmentSize;
+}
+
+}
+
+
+const size_t segmentedContainer::fixedHeaderSize;
+
+
+/**
+* \brief  .
+*
+*       16  (  16),  
+*    4     .
+*      initRoundConsts.
+*
+* \param [in] algorithm  .
+* \param [in] key     32 .
+* \param [in] segmentSize     .
+* \param [in] tagLength     .
+* \param [in] threadCount    (0    ).
+*/
+segmentedContainer::segmentedContainer(cipherAlgorithm algorithm, const uint8_t* key, uint32_t segmentSize,
+                                       size_t tagLength, unsigned threadCount)
+    : algorithm(algorithm), master(algorithm, key) {
+    this->segmentSize = segmentSize < 16 ? 16 : segmentSize / 16 * 16;
+
+    size_t blockSize = blockSizeOf(algorithm);
+    this->tagLength = tagLength < 4 ? 4 : (tagLength > blockSize ? blockSize : tagLength);
+
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    this->threadCount = threadCount == 0 ? 1 : threadCount;
+
+    for (unsigned t = 1; t < this->threadCount; t++) {
+        workers.push_back(std::thread(&segmentedContainer::workerLoop, this));
+    }
+}
+
+
+/**
+* \brief :   .
+*/
+segmentedContainer::~segmentedContainer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeup.notify_all();
+    for (size_t t = 0; t < workers.size(); t++) {
+        workers[t].join();
+    }
+}
+
+
+/**
+* \brief   :       parallelFor    .
+*/
+void segmentedContainer::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wakeup.wait(lock, [this]() { return stopping || openSlots > 0; });
+        if (stopping) {
+            return;
+        }
+        openSlots--;
+        activeWorkers++;
+        const std::function<void()>* run = task;
+        lock.unlock();
+        (*run)();
+        lock.lock();
+        if (--activeWorkers == 0) {
+            done.notify_all();
+        }
+    }
+}
+
+
+/**
+* \brief    f(i, scratch)  i = 0..count-1  threadCount .
+*
+*       ,      ,
+*    bufferPool   .       
+*      scratch  scratchSize  ,  
+*    .        .
+*
+* \param [in] count   .
+* \param [in] scratchSize    scratch.
+* \param [in] f   .
+*/
+void segmentedContainer::parallelFor(uint64_t count, size_t scratchSize,
+                                     const std::function<void(uint64_t, uint8_t*)>& f) {
+    std::atomic<uint64_t> next(0);
+    std::function<void()> body = [&]() {
+        poolBuffer scratch(scratchSize);
+        for (uint64_t i = next++; i < count; i = next++) {
+            f(i, scratch.data());
+        }
+    };
+
+    if (count <= 1 || workers.empty()) {
+        body();
+        return;
+    }
+
+    std::lock_guard<std::mutex> call(callMutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = &body;
+        openSlots = count - 1 < workers.size() ? static_cast<size_t>(count - 1) : workers.size();
+    }
+    wakeup.notify_all();
+    body();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    openSlots = 0;
+    done.wait(lock, [this]() { return activeWorkers == 0; });
+    task = nullptr;
+}
+
+
+/**
+* \brief     (  ).
+*
+* \param [in] container   .
+* \param [in] size    .
+* \param [out] header   .
+* \return  true,          size_t.
+*/
+bool segmentedContainer::parseHeader(const uint8_t* container, size_t size, containerHeader& header) {
+    if (size < fixedHeaderSize || memcmp(container, containerMagic, sizeof(containerMagic)) != 0
+        || container[8] != containerVersion || container[9] > algorithmMagma || container[11] != 0) {
+        return false;
+    }
+
+    header.algorithm = static_cast<cipherAlgorithm>(container[9]);
+    header.tagLength = container[10];
+    header.segmentSize = (static_cast<uint32_t>(container[12]) << 24) | (static_cast<uint32_t>(container[13]) << 16)
+        | (static_cast<uint32_t>(container[14]) << 8) | container[15];
+    header.dataLength = load64(container + 16);
+    memcpy(header.nonce, container + 24, sizeof(header.nonce));
+
+    if (header.tagLength < 4 || header.tagLength > blockSizeOf(header.algorithm)
+        || header.segmentSize == 0 || header.segmentSize % 16 != 0) {
+        return false;
+    }
+
+    // dataLength   :    containerSize   
+    //    .
+    uint64_t limit = SIZE_MAX;
+    if (header.dataLength > limit - headerSize(header)) {
+        return false;
+    }
+    uint64_t available = limit - headerSize(header) - header.dataLength;
+    if (segmentCount(header) + 1 > available / header.tagLength) {
+        return false;
+    }
+
+    return size >= headerSize(header);
+}
+
+
+uint64_t segmentedContainer::segmentCount(const containerHeader& header) {
+    uint64_t count = header.dataLength / header.segmentSize + (header.dataLength % header.segmentSize != 0 ? 1 : 0);
+    return count == 0 ? 1 : count;
+}
+
+
+uint64_t segmentedContainer::headerSize(const containerHeader& header) {
+    return fixedHeaderSize + header.tagLength;
+}
+
+
+/**
+* \brief     .
+*
+* \param [in] header   .
+* \return    : , ,     .
+*/
+uint64_t segmentedContainer::containerSize(const containerHeader& header) {
+    return headerSize(header) + header.dataLength + (segmentCount(header) + 1) * header.tagLength;
+}
+
+
+/**
+* \brief       .
+*
+*   cmacKdf (SP 800-108,  )   "GOSTSEG1"   nonce:
+* keys = K(1) || K(2) || ..., K(i) = MAC(BE32(i) || "GOSTSEG1" || 0x00 || nonce || BE32(512)).
+*
+* \param [in] nonce  nonce  (8 ).
+* \param [out] keys       (64 ).
+*/
+void segmentedContainer::deriveKeys(const uint8_t* nonce, uint8_t* keys) {
+    master.derive(containerMagic, sizeof(containerMagic), nonce, 8, keys, 64);
+}
+
+
+/**
+* \brief    P(i),      MAC.
+*
+* \param [in] index   .
+* \param [in] last    .
+* \param [out] prefix      .
+*/
+void segmentedContainer::segmentPrefix(uint64_t index, bool last, uint8_t* prefix) {
+    memset(prefix, 0, master.getBlockSize());
+    store64(prefix, index | (last ? 1ULL << 63 : 0));
+}
+
+
+bool segmentedContainer::checkHeader(const uint8_t* header, const containerHeader& parsed, const blockCipher& mac) {
+    uint8_t tag[16];
+    mac.imito(header, fixedHeaderSize, tag, parsed.tagLength);
+    return tagsEqual(tag, header + fixedHeaderSize, parsed.tagLength);
+}
+
+
+/**
+* \brief     .
+*
+*      .
+*
+* \param [in] data  .
+* \param [in] length     .
+* \param [out] container  .
+* \return  false,     nonce       .
+*/
+bool segmentedContainer::seal(const uint8_t* data, size_t length, vector<uint8_t>& container) {
+    size_t blockSize = master.getBlockSize();
+    if (algorithm == algorithmMagma && (static_cast<uint64_t>(length) + blockSize - 1) / blockSize > (1ULL << 32)) {
+        return false;
+    }
+
+    containerHeader header = { algorithm, tagLength, segmentSize, length, { 0 } };
+    if (!threadRandom::bytes(header.nonce, sizeof(header.nonce))) {
+        return false;
+    }
+
+    container.assign(static_cast<size_t>(containerSize(header)), 0);
+    uint8_t* out = container.data();
+    memcpy(out, containerMagic, sizeof(containerMagic));
+    out[8] = containerVersion;
+    out[9] = static_cast<uint8_t>(algorithm);
+    out[10] = static_cast<uint8_t>(tagLength);
+    out[11] = 0;
+    store32(out + 12, segmentSize);
+    store64(out + 16, length);
+    memcpy(out + 24, header.nonce, sizeof(header.nonce));
+
+    uint8_t keys[64];
+    deriveKeys(header.nonce, keys);
+    blockCipher gamma(algorithm, keys);
+    blockCipher mac(algorithm, keys + 32);
+    wipe(keys, sizeof(keys));
+
+    mac.imito(out, fixedHeaderSize, out + fixedHeaderSize, tagLength);
+
+    uint64_t count = segmentCount(header);
+    uint8_t* segments = out + headerSize(header);
+    parallelFor(count, 0, [&](uint64_t i, uint8_t*) {
+        size_t segment = static_cast<size_t>(segmentLength(header, i));
+        uint8_t* ciphertext = segments + i * (segmentSize + tagLength);
+        gamma.ctrCrypt(header.nonce, i * segmentSize / blockSize, data + i * segmentSize, ciphertext, segment);
+
+        uint8_t prefix[16];
+        segmentPrefix(i, i + 1 == count, prefix);
+        mac.imito(prefix, ciphertext, segment, ciphertext + segment, tagLength);
+    });
+
+    poolBuffer bound(static_cast<size_t>(fixedHeaderSize + count * tagLength));
+    memcpy(bound.data(), out, fixedHeaderSize);
+    for (uint64_t i = 0; i < count; i++) {
+        size_t segment = static_cast<size_t>(segmentLength(header, i));
+        memcpy(bound.data() + fixedHeaderSize + i * tagLength, segments + i * (segmentSize + tagLength) + segment, tagLength);
+    }
+    mac.imito(bound.data(), bound.size(), out + container.size() - tagLength, tagLength);
+
+    return true;
+}
+
+
+/**
+* \brief      first..last    .
+*
+*  MAC   ,   ,   .
+*
+* \param [in] header   .
+* \param [in] gamma     .
+* \param [in] mac     .
+* \param [in] segments    first  .
+* \param [in] first    .
+* \param [in] last    .
+* \param [in] offset     .
+* \param [out] out   .
+* \param [in] length   .
+* \return  true,    .
+*/
+bool segmentedContainer::processSegments(const containerHeader& header, const blockCipher& gamma,
+                                         const blockCipher& mac, const uint8_t* segments, uint64_t first,
+                                         uint64_t last, uint64_t offset, uint8_t* out, size_t length) {
+    size_t blockSize = gamma.getBlockSize();
+    uint64_t count = segmentCount(header);
+    uint64_t stride = header.segmentSize + header.tagLength;
+    std::atomic<bool> valid(true);
+
+    parallelFor(last - first + 1, header.segmentSize, [&](uint64_t k, uint8_t* scratch) {
+        uint64_t i = first + k;
+        size_t segment = static_cast<size_t>(segmentLength(header, i));
+        const uint8_t* ciphertext = segments + k * stride;
+
+        uint8_t prefix[16];
+        uint8_t tag[16];
+        segmentPrefix(i, i + 1 == count, prefix);
+        mac.imito(prefix, ciphertext, segment, tag, header.tagLength);
+        if (!tagsEqual(tag, ciphertext + segment, header.tagLength)) {
+            valid = false;
+            return;
+        }
+
+        uint64_t start = i * header.segmentSize;
+        uint64_t from = offset > start ? offset - start : 0;
+        uint64_t to = offset + length < start + segment ? offset + length - start : segment;
+        if (from >= to) {
+            return;
+        }
+
+        uint64_t alignedFrom = from / blockSize * blockSize;
+        gamma.ctrCrypt(header.nonce, (start + alignedFrom) / blockSize, ciphertext + alignedFrom, scratch,
+                       static_cast<size_t>(to - alignedFrom));
+        memcpy(out + (start + from - offset), scratch + (from - alignedFrom), static_cast<size_t>(to - from));
+    });
+
+    if (!valid) {
+        wipe(out, length);
+    }
+    return valid;
+}
+
+
+/**
+* \brief      .
+*
+*   ,      .
+*
+* \param [in] container  .
+* \param [in] size     .
+* \param [out] data  .
+* \return  true,       .
+*/
+bool segmentedContainer::open(const uint8_t* container, size_t size, vector<uint8_t>& data) {
+    data.clear();
+
+    containerHeader header;
+    if (!parseHeader(container, size, header) || header.algorithm != algorithm || containerSize(header) != size) {
+        return false;
+    }
+
+    uint8_t keys[64];
+    deriveKeys(header.nonce, keys);
+    blockCipher gamma(algorithm, keys);
+    blockCipher mac(algorithm, keys + 32);
+    wipe(keys, sizeof(keys));
+
+    if (!checkHeader(container, header, mac)) {
+        return false;
+    }
+
+    uint64_t count = segmentCount(header);
+    const uint8_t* segments = container + headerSize(header);
+    poolBuffer bound(static_cast<size_t>(fixedHeaderSize + count * header.tagLength));
+    memcpy(bound.data(), container, fixedHeaderSize);
+    for (uint64_t i = 0; i < count; i++) {
+        size_t segment = static_cast<size_t>(segmentLength(header, i));
+        memcpy(bound.data() + fixedHeaderSize + i * header.tagLength,
+               segments + i * (header.segmentSize + header.tagLength) + segment, header.tagLength);
+    }
+
+    uint8_t tag[16];
+    mac.imito(bound.data(), bound.size(), tag, header.tagLength);
+    if (!tagsEqual(tag, container + size - header.tagLength, header.tagLength)) {
+        return false;
+    }
+
+    data.resize(static_cast<size_t>(header.dataLength));
+    if (!processSegments(header, gamma, mac, segments, 0, count - 1, 0, data.data(), data.size())) {
+        data.clear();
+        return false;
+    }
+
+    return true;
+}
+
+
+/**
+* \brief        .
+*
+*        ,   .
+*
+* \param [in] container  .
+* \param [in] size     .
+* \param [in] offset     .
+* \param [out] out   .
+* \param [in] length   .
+* \return  true,           .
+*/
+bool segmentedContainer::read(const uint8_t* container, size_t size, uint64_t offset, uint8_t* out, size_t length) {
+    containerHeader header;
+    if (!parseHeader(container, size, header) || header.algorithm != algorithm || containerSize(header) != size
+        || offset > header.dataLength || length > header.dataLength - offset) {
+        return false;
+    }
+
+    uint8_t keys[64];
+    deriveKeys(header.nonce, keys);
+    blockCipher gamma(algorithm, keys);
+    blockCipher mac(algorithm, keys + 32);
+    wipe(keys, sizeof(keys));
+
+    if (!checkHeader(container, header, mac)) {
+        return false;
+    }
+    if (length == 0) {
+        return true;
+    }
+
+    uint64_t first = offset / header.segmentSize;
+    uint64_t last = (offset + length - 1) / header.segmentSize;
+    const uint8_t* segments = container + headerSize(header) + first * (header.segmentSize + header.tagLength);
+
+    return processSegments(header, gamma, mac, segments, first, last, offset, out, length);
+}
+
+
+/**
+* \brief       .
+*
+*       ,  .
+*
+* \param [in] path     .
+* \param [in] offset     .
+* \param [out] out   .
+* \param [in] length   .
+* \return  true,   ,          .
+*/
+bool segmentedContainer::readFile(const std::string& path, uint64_t offset, uint8_t* out, size_t length) {
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    in.seekg(0, std::ios::end);
+    uint64_t fileSize = static_cast<uint64_t>(in.tellg());
+    in.seekg(0, std::ios::beg);
+
+    uint8_t headerBytes[fixedHeaderSize + 16];
+    size_t headerRead = fileSize < sizeof(headerBytes) ? static_cast<size_t>(fileSize) : sizeof(headerBytes);
+    containerHeader header;
+    if (!in.read(reinterpret_cast<char*>(headerBytes), headerRead) || !parseHeader(headerBytes, headerRead, header)
+        || header.algorithm != algorithm || containerSize(header) != fileSize
+        || offset > header.dataLength || length > header.dataLength - offset) {
+        return false;
+    }
+
+    uint8_t keys[64];
+    deriveKeys(header.nonce, keys);
+    blockCipher gamma(algorithm, keys);
+    blockCipher mac(algorithm, keys + 32);
+    wipe(keys, sizeof(keys));
+
+    if (!checkHeader(headerBytes, header, mac)) {
+        return false;
+    }
+    if (length == 0) {
+        return true;
+    }
+
+    uint64_t first = offset / header.segmentSize;
+    uint64_t last = (offset + length - 1) / header.segmentSize;
+    uint64_t stride = header.segmentSize + header.tagLength;
+    uint64_t spanSize = (last - first) * stride + segmentLength(header, last) + header.tagLength;
+
+    poolBuffer span(static_cast<size_t>(spanSize));
+    in.seekg(static_cast<std::streamoff>(headerSize(header) + first * stride), std::ios::beg);
+    if (!in.read(reinterpret_cast<char*>(span.data()), static_cast<std::streamsize>(span.size()))) {
+        return false;
+    }
+
+    return processSegments(header, gamma, mac, span.data(), first, last, offset, out, length);
+}
@@ -0,0 +1,101 @@
+#ifndef _SEGMENTED_CONTAINER_H_
+#define _SEGMENTED_CONTAINER_H_
+
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+#include "blockCipher.h"
+#include "cmacKdf.h"
+
+/**
+* \brief  ,    .
+*/
+struct containerHeader {
+    cipherAlgorithm algorithm;
+    size_t tagLength;
+    uint32_t segmentSize;
+    uint64_t dataLength;
+    uint8_t nonce[8];
+};
+
+/**
+* \brief              .
+*
+*  (   big-endian, T   , n    ):
+*   0   8   "GOSTSEG1"
+*   8   1   (1)
+*   9   1   (cipherAlgorithm)
+*   10  1  T ( 4  n)
+*   11  1  0
+*   12  4    S ( 16)
+*   16  8    L
+*   24  8   nonce
+*   32  T   : MAC( 0..31)
+*     i = 0..N-1, N = max(1, ceil(L / S)):  (S ,   )  T  MAC
+*     T   : MAC( 0..31 || MAC  0 || ... || MAC  N-1)
+*
+*          nonce (CMAC  PRF,
+*   SP 800-108),      .
+*  i    CTR     n/2  nonce  ,
+*   i * S / n,       .
+* MAC     P(i) || ,  P(i)  64- 
+* i | (   << 63),    . ,
+*          .
+*           .
+*
+*  ,        threadCount - 1
+*   ,    ,  .
+*   false      ,
+*     .
+*/
+class segmentedContainer {
+public:
+    segmentedContainer(cipherAlgorithm algorithm, const uint8_t* key, uint32_t segmentSize = 64 * 1024,
+                       size_t tagLength = 16, unsigned threadCount = 0);
+    ~segmentedContainer();
+
+    segmentedContainer(const segmentedContainer&) = delete;
+    segmentedContainer& operator=(const segmentedContainer&) = delete;
+
+    bool seal(const uint8_t* data, size_t length, vector<uint8_t>& container);
+    bool open(const uint8_t* container, size_t size, vector<uint8_t>& data);
+    bool read(const uint8_t* container, size_t size, uint64_t offset, uint8_t* out, size_t length);
+    bool readFile(const std::string& path, uint64_t offset, uint8_t* out, size_t length);
+
+    static bool parseHeader(const uint8_t* container, size_t size, containerHeader& header);
+    static uint64_t segmentCount(const containerHeader& header);
+    static uint64_t headerSize(const containerHeader& header);
+    static uint64_t containerSize(const containerHeader& header);
+
+    static const size_t fixedHeaderSize = 32;
+private:
+    void workerLoop();
+    void parallelFor(uint64_t count, size_t scratchSize, const std::function<void(uint64_t, uint8_t*)>& f);
+    void deriveKeys(const uint8_t* nonce, uint8_t* keys);
+    void segmentPrefix(uint64_t index, bool last, uint8_t* prefix);
+    bool checkHeader(const uint8_t* header, const containerHeader& parsed, const blockCipher& mac);
+    bool processSegments(const containerHeader& header, const blockCipher& gamma, const blockCipher& mac,
+                         const uint8_t* segments, uint64_t first, uint64_t last,
+                         uint64_t offset, uint8_t* out, size_t length);
+
+    cipherAlgorithm algorithm;
+    cmacKdf master;
+    uint32_t segmentSize;
+    size_t tagLength;
+    unsigned threadCount;
+
+    std::vector<std::thread> workers;
+    std::mutex callMutex;
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::condition_variable done;
+    const std::function<void()>* task = nullptr;
+    size_t openSlots = 0;
+    size_t activeWorkers = 0;
+    bool stopping = false;
+};
+
+#endif
@@ -0,0 +1,1114 @@
+#include <cstring>
+#include <mutex>
+
+#include <openssl/core.h>
+#include <openssl/core_dispatch.h>
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#include <openssl/evp.h>
+#include <openssl/crypto.h>
+
+#include "gost12_15.h"
+#include "autotuner.h"
+
+/*
+*  OpenSSL 3      (  34.12-2015,     34.13-2015):
+* KUZNYECHIK-ECB, KUZNYECHIK-CBC, KUZNYECHIK-CTR, KUZNYECHIK-MGM ( 1323565.1.026-2019, RFC 9058)
+*   KUZNYECHIK-MAC (CMAC).
+*     gost12_15  ,  autotuner
+* (. autotuner::tuneFromEnvironment).
+*/
+
+namespace {
+
+const size_t blockSize = 16;
+const size_t keySize = 32;
+const size_t ctrSyncSize = 8;
+// ,    encryptBlocks
+const size_t chunkBlocks = 32;
+
+enum cipherMode {
+    modeEcb,
+    modeCbc,
+    modeCtr,
+    modeMgm
+};
+
+struct cipherContext {
+    cipherMode mode;
+    bool encrypting;
+    bool keySet;
+    bool ivSet;
+    bool padding;
+    expandedKey key;
+    uint8_t iv[blockSize];
+
+    //ECB, CBC:  ; CTR, MGM:   
+    uint8_t buffer[blockSize];
+    size_t bufferLength;
+    uint64_t counter;
+
+    //MGM:  Y ()  Z ( ), ,  
+    bool mgmStarted;
+    bool mgmData;
+    uint8_t y[blockSize];
+    uint8_t z[blockSize];
+    uint8_t sum[blockSize];
+    uint8_t aad[blockSize];
+    size_t aadLength;
+    uint8_t data[blockSize];
+    uint64_t aadTotal;
+    uint64_t dataTotal;
+    uint8_t tag[blockSize];
+    size_t tagLength;
+    bool tagReady;
+};
+
+struct macContext {
+    bool keySet;
+    expandedKey key;
+    uint8_t k1[blockSize];
+    uint8_t k2[blockSize];
+    uint8_t state[blockSize];
+    uint8_t buffer[blockSize];
+    size_t bufferLength;
+    size_t size;
+};
+
+
+gost12_15& cipher() {
+    return gost12_15::getInstance();
+}
+
+
+void initCipher() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        cipher().initRoundConsts();
+        autotuner::getInstance().tuneFromEnvironment();
+    });
+}
+
+
+void xorBlock(uint8_t* out, const uint8_t* a, const uint8_t* b, size_t length = blockSize) {
+    for (size_t i = 0; i < length; i++) {
+        out[i] = a[i] ^ b[i];
+    }
+}
+
+
+uint64_t load64(const uint8_t* data) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value = (value << 8) | data[i];
+    }
+    return value;
+}
+
+
+void store64(uint8_t* data, uint64_t value) {
+    for (int i = 7; i >= 0; i--) {
+        data[i] = static_cast<uint8_t>(value);
+        value >>= 8;
+    }
+}
+
+
+/**
+* \brief    GF(2^128)   x^128 + x^7 + x^2 + x + 1 (  ).
+*
+*     .
+*/
+void gfMultiply(const uint8_t* a, const uint8_t* b, uint8_t* out) {
+    uint64_t vHigh = load64(a);
+    uint64_t vLow = load64(a + 8);
+    uint64_t bHigh = load64(b);
+    uint64_t bLow = load64(b + 8);
+    uint64_t zHigh = 0;
+    uint64_t zLow = 0;
+
+    for (int i = 0; i < 128; i++) {
+        uint64_t bit = i < 64 ? (bLow >> i) & 1 : (bHigh >> (i - 64)) & 1;
+        uint64_t mask = 0 - bit;
+        zHigh ^= vHigh & mask;
+        zLow ^= vLow & mask;
+
+        uint64_t carry = 0 - (vHigh >> 63);
+        vHigh = (vHigh << 1) | (vLow >> 63);
+        vLow = (vLow << 1) ^ (carry & 0x87);
+    }
+
+    store64(out, zHigh);
+    store64(out + 8, zLow);
+}
+
+
+/*
+* 
+*/
+
+void* cipherNew(cipherMode mode) {
+    initCipher();
+
+    cipherContext* ctx = static_cast<cipherContext*>(OPENSSL_zalloc(sizeof(cipherContext)));
+    if (ctx) {
+        ctx->mode = mode;
+        ctx->padding = true;
+        ctx->tagLength = blockSize;
+    }
+    return ctx;
+}
+
+
+template <cipherMode M>
+void* cipherNewMode(void*) {
+    return cipherNew(M);
+}
+
+
+void cipherFree(void* vctx) {
+    OPENSSL_clear_free(vctx, sizeof(cipherContext));
+}
+
+
+void* cipherDup(void* vctx) {
+    cipherContext* ctx = static_cast<cipherContext*>(OPENSSL_malloc(sizeof(cipherContext)));
+    if (ctx) {
+        memcpy(ctx, vctx, sizeof(cipherContext));
+    }
+    return ctx;
+}
+
+
+size_t ivLength(cipherMode mode) {
+    switch (mode) {
+    case modeEcb:
+        return 0;
+    case modeCtr:
+        return ctrSyncSize;
+    default:
+        return blockSize;
+    }
+}
+
+
+void cipherReset(cipherContext* ctx) {
+    ctx->bufferLength = 0;
+    ctx->counter = 0;
+    ctx->mgmStarted = false;
+    ctx->mgmData = false;
+    ctx->aadLength = 0;
+    ctx->aadTotal = 0;
+    ctx->dataTotal = 0;
+    ctx->tagReady = false;
+}
+
+
+int cipherSetParams(void* vctx, const OSSL_PARAM params[]);
+
+
+int cipherInit(void* vctx, const unsigned char* key, size_t keyLength, const unsigned char* iv, size_t ivLen,
+               const OSSL_PARAM params[], bool encrypting) {
+    cipherContext* ctx = static_cast<cipherContext*>(vctx);
+    ctx->encrypting = encrypting;
+
+    if (key) {
+        if (keyLength != keySize) {
+            return 0;
+        }
+        cipher().expandKey(key, ctx->key);
+        ctx->keySet = true;
+    }
+
+    if (iv) {
+        if (ivLen < ivLength(ctx->mode)) {
+            return 0;
+        }
+        memcpy(ctx->iv, iv, ivLength(ctx->mode));
+        ctx->ivSet = true;
+    }
+
+    cipherReset(ctx);
+    return cipherSetParams(vctx, params);
+}
+
+
+int cipherEncryptInit(void* vctx, const unsigned char* key, size_t keyLength, const unsigned char* iv, size_t ivLen,
+                      const OSSL_PARAM params[]) {
+    return cipherInit(vctx, key, keyLength, iv, ivLen, params, true);
+}
+
+
+int cipherDecryptInit(void* vctx, const unsigned char* key, size_t keyLength, const unsigned char* iv, size_t ivLen,
+                      const OSSL_PARAM params[]) {
+    return cipherInit(vctx, key, keyLength, iv, ivLen, params, false);
+}
+
+
+/**
+* \brief       ECB  CBC.
+*/
+void processBlocks(cipherContext* ctx, const uint8_t* in, uint8_t* out, size_t blocks) {
+    if (ctx->mode == modeEcb) {
+        if (ctx->encrypting) {
+            cipher().encryptBlocks(ctx->key, in, out, blocks);
+        }
+        else {
+            cipher().decryptBlocks(ctx->key, in, out, blocks);
+        }
+        return;
+    }
+
+    if (ctx->encrypting) {
+        for (size_t i = 0; i < blocks; i++) {
+            xorBlock(ctx->iv, ctx->iv, in + i * blockSize);
+            cipher().encryptBlocks(ctx->key, ctx->iv, ctx->iv, 1);
+            memcpy(out + i * blockSize, ctx->iv, blockSize);
+        }
+        return;
+    }
+
+    uint8_t saved[chunkBlocks * blockSize];
+    while (blocks > 0) {
+        size_t n = blocks < chunkBlocks ? blocks : chunkBlocks;
+        memcpy(saved, in, n * blockSize);
+        cipher().decryptBlocks(ctx->key, saved, out, n);
+
+        xorBlock(out, out, ctx->iv);
+        for (size_t i = 1; i < n; i++) {
+            xorBlock(out + i * blockSize, out + i * blockSize, saved + (i - 1) * blockSize);
+        }
+        memcpy(ctx->iv, saved + (n - 1) * blockSize, blockSize);
+
+        in += n * blockSize;
+        out += n * blockSize;
+        blocks -= n;
+    }
+}
+
+
+int blockUpdate(cipherContext* ctx, unsigned char* out, size_t* outl, size_t outsize, const unsigned char* in,
+                size_t inl) {
+    size_t available = ctx->bufferLength + inl;
+    size_t blocks = available / blockSize;
+    if (!ctx->encrypting && ctx->padding && available % blockSize == 0 && blocks > 0) {
+        blocks--;
+    }
+
+    if (outsize < blocks * blockSize) {
+        return 0;
+    }
+
+    size_t written = 0;
+    if (blocks > 0 && ctx->bufferLength > 0) {
+        size_t fill = blockSize - ctx->bufferLength;
+        memcpy(ctx->buffer + ctx->bufferLength, in, fill);
+        processBlocks(ctx, ctx->buffer, out, 1);
+        in += fill;
+        inl -= fill;
+        ctx->bufferLength = 0;
+        written = blockSize;
+        blocks--;
+    }
+
+    if (blocks > 0) {
+        processBlocks(ctx, in, out + written, blocks);
+        in += blocks * blockSize;
+        inl -= blocks * blockSize;
+        written += blocks * blockSize;
+    }
+
+    memcpy(ctx->buffer + ctx->bufferLength, in, inl);
+    ctx->bufferLength += inl;
+    *outl = written;
+    return 1;
+}
+
+
+int blockFinal(cipherContext* ctx, unsigned char* out, size_t* outl, size_t outsize) {
+    *outl = 0;
+
+    if (!ctx->padding) {
+        return ctx->bufferLength == 0;
+    }
+
+    if (outsize < blockSize) {
+        return 0;
+    }
+
+    if (ctx->encrypting) {
+        uint8_t pad = static_cast<uint8_t>(blockSize - ctx->bufferLength);
+        memset(ctx->buffer + ctx->bufferLength, pad, pad);
+        processBlocks(ctx, ctx->buffer, out, 1);
+        ctx->bufferLength = 0;
+        *outl = blockSize;
+        return 1;
+    }
+
+    if (ctx->bufferLength != blockSize) {
+        return 0;
+    }
+
+    uint8_t block[blockSize];
+    processBlocks(ctx, ctx->buffer, block, 1);
+    ctx->bufferLength = 0;
+
+    uint8_t pad = block[blockSize - 1];
+    if (pad == 0 || pad > blockSize) {
+        return 0;
+    }
+    for (size_t i = blockSize - pad; i < blockSize; i++) {
+        if (block[i] != pad) {
+            return 0;
+        }
+    }
+
+    memcpy(out, block, blockSize - pad);
+    *outl = blockSize - pad;
+    OPENSSL_cleanse(block, sizeof(block));
+    return 1;
+}
+
+
+/**
+* \brief     CTR    34.13-2015 (  0    ).
+*/
+void ctrUpdate(cipherContext* ctx, unsigned char* out, const unsigned char* in, size_t inl) {
+    while (inl > 0 && ctx->bufferLength > 0) {
+        *out++ = *in++ ^ ctx->buffer[blockSize - ctx->bufferLength];
+        ctx->bufferLength--;
+        inl--;
+    }
+
+    size_t full = inl / blockSize * blockSize;
+    if (full > 0) {
+        cipher().gammaCryptionBlocks(ctx->key, ctx->iv, ctx->counter, in, out, full);
+        ctx->counter += full / blockSize;
+        in += full;
+        out += full;
+        inl -= full;
+    }
+
+    if (inl > 0) {
+        memset(ctx->buffer, 0, blockSize);
+        cipher().gammaCryptionBlocks(ctx->key, ctx->iv, ctx->counter, ctx->buffer, ctx->buffer, blockSize);
+        ctx->counter++;
+        xorBlock(out, in, ctx->buffer, inl);
+        ctx->bufferLength = blockSize - inl;
+    }
+}
+
+
+/**
+* \brief   MGM: Y1 = E(0 || nonce), Z1 = E(1 || nonce).
+*/
+void mgmStart(cipherContext* ctx) {
+    memcpy(ctx->y, ctx->iv, blockSize);
+    ctx->y[0] &= 0x7f;
+    memcpy(ctx->z, ctx->iv, blockSize);
+    ctx->z[0] |= 0x80;
+    cipher().encryptBlocks(ctx->key, ctx->y, ctx->y, 1);
+    cipher().encryptBlocks(ctx->key, ctx->z, ctx->z, 1);
+    memset(ctx->sum, 0, blockSize);
+    ctx->mgmStarted = true;
+}
+
+
+/**
+* \brief      MGM: sum ^= H_i * block_i, H_i = E(Z_i), Z_(i+1) = incr_l(Z_i).
+*/
+void mgmAbsorb(cipherContext* ctx, const uint8_t* blocks, size_t count) {
+    uint8_t h[chunkBlocks * blockSize];
+    uint8_t product[blockSize];
+
+    while (count > 0) {
+        size_t n = count < chunkBlocks ? count : chunkBlocks;
+        for (size_t i = 0; i < n; i++) {
+            memcpy(h + i * blockSize, ctx->z, blockSize);
+            store64(ctx->z, load64(ctx->z) + 1);
+        }
+        cipher().encryptBlocks(ctx->key, h, h, n);
+
+        for (size_t i = 0; i < n; i++) {
+            gfMultiply(h + i * blockSize, blocks + i * blockSize, product);
+            xorBlock(ctx->sum, ctx->sum, product);
+        }
+
+        blocks += n * blockSize;
+        count -= n;
+    }
+
+    OPENSSL_cleanse(h, sizeof(h));
+}
+
+
+/**
+* \brief   count   MGM: E(Y_i), Y_(i+1) = incr_r(Y_i).
+*/
+void mgmKeystream(cipherContext* ctx, uint8_t* gamma, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        memcpy(gamma + i * blockSize, ctx->y, blockSize);
+        store64(ctx->y + 8, load64(ctx->y + 8) + 1);
+    }
+    cipher().encryptBlocks(ctx->key, gamma, gamma, count);
+}
+
+
+void mgmAad(cipherContext* ctx, const unsigned char* in, size_t inl) {
+    ctx->aadTotal += inl;
+
+    if (ctx->aadLength > 0) {
+        size_t fill = blockSize - ctx->aadLength < inl ? blockSize - ctx->aadLength : inl;
+        memcpy(ctx->aad + ctx->aadLength, in, fill);
+        ctx->aadLength += fill;
+        in += fill;
+        inl -= fill;
+        if (ctx->aadLength < blockSize) {
+            return;
+        }
+        mgmAbsorb(ctx, ctx->aad, 1);
+        ctx->aadLength = 0;
+    }
+
+    size_t blocks = inl / blockSize;
+    mgmAbsorb(ctx, in, blocks);
+    memcpy(ctx->aad, in + blocks * blockSize, inl - blocks * blockSize);
+    ctx->aadLength = inl - blocks * blockSize;
+}
+
+
+/**
+* \brief    MGM     .
+*
+*      data,     buffer.
+*/
+void mgmData(cipherContext* ctx, unsigned char* out, const unsigned char* in, size_t inl) {
+    if (!ctx->mgmData) {
+        if (ctx->aadLength > 0) {
+            memset(ctx->aad + ctx->aadLength, 0, blockSize - ctx->aadLength);
+            mgmAbsorb(ctx, ctx->aad, 1);
+            ctx->aadLength = 0;
+        }
+        ctx->mgmData = true;
+    }
+    ctx->dataTotal += inl;
+
+    while (inl > 0 && ctx->bufferLength > 0) {
+        size_t position = blockSize - ctx->bufferLength;
+        uint8_t c = ctx->encrypting ? *in ^ ctx->buffer[position] : *in;
+        *out++ = *in++ ^ ctx->buffer[position];
+        ctx->data[position] = c;
+        ctx->bufferLength--;
+        inl--;
+
+        if (ctx->bufferLength == 0) {
+            mgmAbsorb(ctx, ctx->data, 1);
+        }
+    }
+
+    uint8_t gamma[chunkBlocks * blockSize];
+    while (inl >= blockSize) {
+        size_t n = inl / blockSize < chunkBlocks ? inl / blockSize : chunkBlocks;
+        mgmKeystream(ctx, gamma, n);
+
+        if (ctx->encrypting) {
+            xorBlock(out, in, gamma, n * blockSize);
+            mgmAbsorb(ctx, out, n);
+        }
+        else {
+            mgmAbsorb(ctx, in, n);
+            xorBlock(out, in, gamma, n * blockSize);
+        }
+
+        in += n * blockSize;
+        out += n * blockSize;
+        inl -= n * blockSize;
+    }
+
+    if (inl > 0) {
+        mgmKeystream(ctx, ctx->buffer, 1);
+        memset(ctx->data, 0, blockSize);
+        for (size_t i = 0; i < inl; i++) {
+            ctx->data[i] = ctx->encrypting ? in[i] ^ ctx->buffer[i] : in[i];
+            out[i] = in[i] ^ ctx->buffer[i];
+        }
+        ctx->bufferLength = blockSize - inl;
+    }
+
+    OPENSSL_cleanse(gamma, sizeof(gamma));
+}
+
+
+/**
+* \brief   MGM:   len(A) || len(C)  , tag = E(sum).
+*/
+int mgmFinal(cipherContext* ctx) {
+    if (!ctx->mgmStarted) {
+        mgmStart(ctx);
+    }
+    if (!ctx->mgmData) {
+        mgmData(ctx, nullptr, nullptr, 0);
+    }
+
+    if (ctx->bufferLength > 0) {
+        size_t used = blockSize - ctx->bufferLength;
+        memset(ctx->data + used, 0, blockSize - used);
+        mgmAbsorb(ctx, ctx->data, 1);
+        ctx->bufferLength = 0;
+    }
+
+    uint8_t lengths[blockSize];
+    store64(lengths, ctx->aadTotal * 8);
+    store64(lengths + 8, ctx->dataTotal * 8);
+    mgmAbsorb(ctx, lengths, 1);
+
+    uint8_t tag[blockSize];
+    cipher().encryptBlocks(ctx->key, ctx->sum, tag, 1);
+
+    if (ctx->encrypting) {
+        memcpy(ctx->tag, tag, blockSize);
+        ctx->tagReady = true;
+        return 1;
+    }
+
+    return ctx->tagReady && CRYPTO_memcmp(tag, ctx->tag, ctx->tagLength) == 0;
+}
+
+
+int cipherUpdate(void* vctx, unsigned char* out, size_t* outl, size_t outsize, const unsigned char* in, size_t inl) {
+    cipherContext* ctx = static_cast<cipherContext*>(vctx);
+    if (!ctx->keySet || (ctx->mode != modeEcb && !ctx->ivSet)) {
+        return 0;
+    }
+
+    switch (ctx->mode) {
+    case modeEcb:
+    case modeCbc:
+        return blockUpdate(ctx, out, outl, outsize, in, inl);
+    case modeCtr:
+        if (outsize < inl) {
+            return 0;
+        }
+        ctrUpdate(ctx, out, in, inl);
+        *outl = inl;
+        return 1;
+    case modeMgm:
+        if (!ctx->mgmStarted) {
+            mgmStart(ctx);
+        }
+        if (out == nullptr) {
+            if (ctx->mgmData) {
+                return 0;
+            }
+            mgmAad(ctx, in, inl);
+            *outl = inl;
+            return 1;
+        }
+        if (outsize < inl) {
+            return 0;
+        }
+        mgmData(ctx, out, in, inl);
+        *outl = inl;
+        return 1;
+    }
+
+    return 0;
+}
+
+
+int cipherFinal(void* vctx, unsigned char* out, size_t* outl, size_t outsize) {
+    cipherContext* ctx = static_cast<cipherContext*>(vctx);
+    if (!ctx->keySet || (ctx->mode != modeEcb && !ctx->ivSet)) {
+        return 0;
+    }
+
+    *outl = 0;
+    switch (ctx->mode) {
+    case modeEcb:
+    case modeCbc:
+        return blockFinal(ctx, out, outl, outsize);
+    case modeCtr:
+        return 1;
+    case modeMgm:
+        return mgmFinal(ctx);
+    }
+
+    return 0;
+}
+
+
+int cipherOneShot(void* vctx, unsigned char* out, size_t* outl, size_t outsize, const unsigned char* in, size_t inl) {
+    cipherContext* ctx = static_cast<cipherContext*>(vctx);
+    if ((ctx->mode == modeEcb || ctx->mode == modeCbc) && inl % blockSize != 0) {
+        return 0;
+    }
+
+    bool padding = ctx->padding;
+    ctx->padding = false;
+    int result = cipherUpdate(vctx, out, outl, outsize, in, inl);
+    ctx->padding = padding;
+    return result;
+}
+
+
+template <cipherMode M>
+int cipherGetParams(OSSL_PARAM params[]) {
+    static const unsigned int modes[] = { EVP_CIPH_ECB_MODE, EVP_CIPH_CBC_MODE, EVP_CIPH_CTR_MODE, EVP_CIPH_STREAM_CIPHER };
+    OSSL_PARAM* p;
+
+    if ((p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_MODE)) && !OSSL_PARAM_set_uint(p, modes[M])) {
+        return 0;
+    }
+    if ((p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_KEYLEN)) && !OSSL_PARAM_set_size_t(p, keySize)) {
+        return 0;
+    }
+    if ((p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_IVLEN)) && !OSSL_PARAM_set_size_t(p, ivLength(M))) {
+        return 0;
+    }
+    if ((p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_BLOCK_SIZE))
+        && !OSSL_PARAM_set_size_t(p, M == modeEcb || M == modeCbc ? blockSize : 1)) {
+        return 0;
+    }
+    if ((p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_AEAD)) && !OSSL_PARAM_set_int(p, M == modeMgm)) {
+        return 0;
+    }
+    if ((p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_CUSTOM_IV)) && !OSSL_PARAM_set_int(p, 0)) {
+        return 0;
+    }
+    if ((p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_CTS)) && !OSSL_PARAM_set_int(p, 0)) {
+        return 0;
+    }
+    if ((p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_TLS1_MULTIBLOCK)) && !OSSL_PARAM_set_int(p, 0)) {
+        return 0;
+    }
+    if ((p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_HAS_RAND_KEY)) && !OSSL_PARAM_set_int(p, 0)) {
+        return 0;
+    }
+    return 1;
+}
+
+
+const OSSL_PARAM* cipherGettableParams(void*) {
+    static const OSSL_PARAM table[] = {
+        OSSL_PARAM_uint(OSSL_CIPHER_PARAM_MODE, nullptr),
+        OSSL_PARAM_size_t(OSSL_CIPHER_PARAM_KEYLEN, nullptr),
+        OSSL_PARAM_size_t(OSSL_CIPHER_PARAM_IVLEN, nullptr),
+        OSSL_PARAM_size_t(OSSL_CIPHER_PARAM_BLOCK_SIZE, nullptr),
+        OSSL_PARAM_int(OSSL_CIPHER_PARAM_AEAD, nullptr),
+        OSSL_PARAM_int(OSSL_CIPHER_PARAM_CUSTOM_IV, nullptr),
+        OSSL_PARAM_int(OSSL_CIPHER_PARAM_CTS, nullptr),
+        OSSL_PARAM_int(OSSL_CIPHER_PARAM_TLS1_MULTIBLOCK, nullptr),
+        OSSL_PARAM_int(OSSL_CIPHER_PARAM_HAS_RAND_KEY, nullptr),
+        OSSL_PARAM_END
+    };
+    return table;
+}
+
+
+int cipherGetCtxParams(void* vctx, OSSL_PARAM params[]) {
+    cipherContext* ctx = static_cast<cipherContext*>(vctx);
+    OSSL_PARAM* p;
+
+    if ((p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_IVLEN)) && !OSSL_PARAM_set_size_t(p, ivLength(ctx->mode))) {
+        return 0;
+    }
+    if ((p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_KEYLEN)) && !OSSL_PARAM_set_size_t(p, keySize)) {
+        return 0;
+    }
+    if ((p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_PADDING)) && !OSSL_PARAM_set_uint(p, ctx->padding)) {
+        return 0;
+    }
+    if ((p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_IV))
+        && !OSSL_PARAM_set_octet_string(p, ctx->iv, ivLength(ctx->mode))) {
+        return 0;
+    }
+    if ((p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_UPDATED_IV))
+        && !OSSL_PARAM_set_octet_string(p, ctx->iv, ivLength(ctx->mode))) {
+        return 0;
+    }
+    if ((p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_AEAD_TAGLEN))
+        && !OSSL_PARAM_set_size_t(p, ctx->tagLength)) {
+        return 0;
+    }
+    if ((p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_AEAD_TAG))) {
+        if (ctx->mode != modeMgm || !ctx->encrypting || !ctx->tagReady || p->data_size == 0
+            || p->data_size > blockSize || !OSSL_PARAM_set_octet_string(p, ctx->tag, p->data_size)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+int cipherSetParams(void* vctx, const OSSL_PARAM params[]) {
+    cipherContext* ctx = static_cast<cipherContext*>(vctx);
+    const OSSL_PARAM* p;
+
+    if (params == nullptr) {
+        return 1;
+    }
+
+    if ((p = OSSL_PARAM_locate_const(params, OSSL_CIPHER_PARAM_PADDING))) {
+        unsigned int padding;
+        if (!OSSL_PARAM_get_uint(p, &padding)) {
+            return 0;
+        }
+        ctx->padding = padding != 0;
+    }
+    if ((p = OSSL_PARAM_locate_const(params, OSSL_CIPHER_PARAM_KEYLEN))) {
+        size_t length;
+        if (!OSSL_PARAM_get_size_t(p, &length) || length != keySize) {
+            return 0;
+        }
+    }
+    if ((p = OSSL_PARAM_locate_const(params, OSSL_CIPHER_PARAM_AEAD_IVLEN))) {
+        size_t length;
+        if (!OSSL_PARAM_get_size_t(p, &length) || length != ivLength(ctx->mode)) {
+            return 0;
+        }
+    }
+    if ((p = OSSL_PARAM_locate_const(params, OSSL_CIPHER_PARAM_AEAD_TAG))) {
+        if (ctx->mode != modeMgm || p->data_size == 0 || p->data_size > blockSize) {
+            return 0;
+        }
+        if (p->data != nullptr) {
+            if (ctx->encrypting) {
+                return 0;
+            }
+            memcpy(ctx->tag, p->data, p->data_size);
+            ctx->tagReady = true;
+        }
+        ctx->tagLength = p->data_size;
+    }
+    return 1;
+}
+
+
+const OSSL_PARAM* cipherGettableCtxParams(void*, void*) {
+    static const OSSL_PARAM table[] = {
+        OSSL_PARAM_size_t(OSSL_CIPHER_PARAM_IVLEN, nullptr),
+        OSSL_PARAM_size_t(OSSL_CIPHER_PARAM_KEYLEN, nullptr),
+        OSSL_PARAM_uint(OSSL_CIPHER_PARAM_PADDING, nullptr),
+        OSSL_PARAM_octet_string(OSSL_CIPHER_PARAM_IV, nullptr, 0),
+        OSSL_PARAM_octet_string(OSSL_CIPHER_PARAM_UPDATED_IV, nullptr, 0),
+        OSSL_PARAM_size_t(OSSL_CIPHER_PARAM_AEAD_TAGLEN, nullptr),
+        OSSL_PARAM_octet_string(OSSL_CIPHER_PARAM_AEAD_TAG, nullptr, 0),
+        OSSL_PARAM_END
+    };
+    return table;
+}
+
+
+const OSSL_PARAM* cipherSettableCtxParams(void*, void*) {
+    static const OSSL_PARAM table[] = {
+        OSSL_PARAM_uint(OSSL_CIPHER_PARAM_PADDING, nullptr),
+        OSSL_PARAM_size_t(OSSL_CIPHER_PARAM_KEYLEN, nullptr),
+        OSSL_PARAM_size_t(OSSL_CIPHER_PARAM_AEAD_IVLEN, nullptr),
+        OSSL_PARAM_octet_string(OSSL_CIPHER_PARAM_AEAD_TAG, nullptr, 0),
+        OSSL_PARAM_END
+    };
+    return table;
+}
+
+
+typedef void (*dispatchFunction)(void);
+
+template <cipherMode M>
+struct cipherDispatch {
+    static const OSSL_DISPATCH table[];
+};
+
+template <cipherMode M>
+const OSSL_DISPATCH cipherDispatch<M>::table[] = {
+    { OSSL_FUNC_CIPHER_NEWCTX, reinterpret_cast<dispatchFunction>(&cipherNewMode<M>) },
+    { OSSL_FUNC_CIPHER_FREECTX, reinterpret_cast<dispatchFunction>(&cipherFree) },
+    { OSSL_FUNC_CIPHER_DUPCTX, reinterpret_cast<dispatchFunction>(&cipherDup) },
+    { OSSL_FUNC_CIPHER_ENCRYPT_INIT, reinterpret_cast<dispatchFunction>(&cipherEncryptInit) },
+    { OSSL_FUNC_CIPHER_DECRYPT_INIT, reinterpret_cast<dispatchFunction>(&cipherDecryptInit) },
+    { OSSL_FUNC_CIPHER_UPDATE, reinterpret_cast<dispatchFunction>(&cipherUpdate) },
+    { OSSL_FUNC_CIPHER_FINAL, reinterpret_cast<dispatchFunction>(&cipherFinal) },
+    { OSSL_FUNC_CIPHER_CIPHER, reinterpret_cast<dispatchFunction>(&cipherOneShot) },
+    { OSSL_FUNC_CIPHER_GET_PARAMS, reinterpret_cast<dispatchFunction>(&cipherGetParams<M>) },
+    { OSSL_FUNC_CIPHER_GETTABLE_PARAMS, reinterpret_cast<dispatchFunction>(&cipherGettableParams) },
+    { OSSL_FUNC_CIPHER_GET_CTX_PARAMS, reinterpret_cast<dispatchFunction>(&cipherGetCtxParams) },
+    { OSSL_FUNC_CIPHER_SET_CTX_PARAMS, reinterpret_cast<dispatchFunction>(&cipherSetParams) },
+    { OSSL_FUNC_CIPHER_GETTABLE_CTX_PARAMS, reinterpret_cast<dispatchFunction>(&cipherGettableCtxParams) },
+    { OSSL_FUNC_CIPHER_SETTABLE_CTX_PARAMS, reinterpret_cast<dispatchFunction>(&cipherSettableCtxParams) },
+    { 0, nullptr }
+};
+
+
+/*
+*  (CMAC    34.13-2015)
+*/
+
+void* macNew(void*) {
+    initCipher();
+
+    macContext* ctx = static_cast<macContext*>(OPENSSL_zalloc(sizeof(macContext)));
+    if (ctx) {
+        ctx->size = blockSize;
+    }
+    return ctx;
+}
+
+
+void macFree(void* vctx) {
+    OPENSSL_clear_free(vctx, sizeof(macContext));
+}
+
+
+void* macDup(void* vctx) {
+    macContext* ctx = static_cast<macContext*>(OPENSSL_malloc(sizeof(macContext)));
+    if (ctx) {
+        memcpy(ctx, vctx, sizeof(macContext));
+    }
+    return ctx;
+}
+
+
+bool macSetKey(macContext* ctx, const unsigned char* key, size_t keyLength) {
+    if (keyLength != keySize) {
+        return false;
+    }
+
+    cipher().expandKey(key, ctx->key);
+    cipher().getImitoKeys(ctx->key, ctx->k1, ctx->k2);
+    ctx->keySet = true;
+    return true;
+}
+
+
+int macSetCtxParams(void* vctx, const OSSL_PARAM params[]) {
+    macContext* ctx = static_cast<macContext*>(vctx);
+    const OSSL_PARAM* p;
+
+    if (params == nullptr) {
+        return 1;
+    }
+
+    if ((p = OSSL_PARAM_locate_const(params, OSSL_MAC_PARAM_KEY))) {
+        if (p->data_type != OSSL_PARAM_OCTET_STRING
+            || !macSetKey(ctx, static_cast<const unsigned char*>(p->data), p->data_size)) {
+            return 0;
+        }
+    }
+    if ((p = OSSL_PARAM_locate_const(params, OSSL_MAC_PARAM_SIZE))) {
+        size_t size;
+        if (!OSSL_PARAM_get_size_t(p, &size) || size == 0 || size > blockSize) {
+            return 0;
+        }
+        ctx->size = size;
+    }
+    return 1;
+}
+
+
+int macInit(void* vctx, const unsigned char* key, size_t keyLength, const OSSL_PARAM params[]) {
+    macContext* ctx = static_cast<macContext*>(vctx);
+
+    if (!macSetCtxParams(vctx, params)) {
+        return 0;
+    }
+    if (key && !macSetKey(ctx, key, keyLength)) {
+        return 0;
+    }
+    if (!ctx->keySet) {
+        return 0;
+    }
+
+    memset(ctx->state, 0, blockSize);
+    ctx->bufferLength = 0;
+    return 1;
+}
+
+
+/**
+* \brief   :  (, )      .
+*/
+int macUpdate(void* vctx, const unsigned char* in, size_t inl) {
+    macContext* ctx = static_cast<macContext*>(vctx);
+
+    while (inl > 0) {
+        if (ctx->bufferLength == blockSize) {
+            xorBlock(ctx->state, ctx->state, ctx->buffer);
+            cipher().encryptBlocks(ctx->key, ctx->state, ctx->state, 1);
+            ctx->bufferLength = 0;
+        }
+
+        size_t fill = blockSize - ctx->bufferLength < inl ? blockSize - ctx->bufferLength : inl;
+        memcpy(ctx->buffer + ctx->bufferLength, in, fill);
+        ctx->bufferLength += fill;
+        in += fill;
+        inl -= fill;
+    }
+
+    return 1;
+}
+
+
+int macFinal(void* vctx, unsigned char* out, size_t* outl, size_t outsize) {
+    macContext* ctx = static_cast<macContext*>(vctx);
+    if (outsize < ctx->size) {
+        return 0;
+    }
+
+    uint8_t last[blockSize];
+    if (ctx->bufferLength == blockSize) {
+        xorBlock(last, ctx->buffer, ctx->k1);
+    }
+    else {
+        memset(last, 0, blockSize);
+        memcpy(last, ctx->buffer, ctx->bufferLength);
+        last[ctx->bufferLength] = 0x80;
+        xorBlock(last, last, ctx->k2);
+    }
+
+    xorBlock(ctx->state, ctx->state, last);
+    cipher().encryptBlocks(ctx->key, ctx->state, ctx->state, 1);
+    memcpy(out, ctx->state, ctx->size);
+    *outl = ctx->size;
+
+    OPENSSL_cleanse(last, sizeof(last));
+    return 1;
+}
+
+
+int macGetCtxParams(void* vctx, OSSL_PARAM params[]) {
+    macContext* ctx = static_cast<macContext*>(vctx);
+    OSSL_PARAM* p;
+
+    if ((p = OSSL_PARAM_locate(params, OSSL_MAC_PARAM_SIZE)) && !OSSL_PARAM_set_size_t(p, ctx->size)) {
+        return 0;
+    }
+    if ((p = OSSL_PARAM_locate(params, OSSL_MAC_PARAM_BLOCK_SIZE)) && !OSSL_PARAM_set_size_t(p, blockSize)) {
+        return 0;
+    }
+    return 1;
+}
+
+
+const OSSL_PARAM* macGettableCtxParams(void*, void*) {
+    static const OSSL_PARAM table[] = {
+        OSSL_PARAM_size_t(OSSL_MAC_PARAM_SIZE, nullptr),
+        OSSL_PARAM_size_t(OSSL_MAC_PARAM_BLOCK_SIZE, nullptr),
+        OSSL_PARAM_END
+    };
+    return table;
+}
+
+
+const OSSL_PARAM* macSettableCtxParams(void*, void*) {
+    static const OSSL_PARAM table[] = {
+        OSSL_PARAM_octet_string(OSSL_MAC_PARAM_KEY, nullptr, 0),
+        OSSL_PARAM_size_t(OSSL_MAC_PARAM_SIZE, nullptr),
+        OSSL_PARAM_END
+    };
+    return table;
+}
+
+
+const OSSL_DISPATCH macDispatch[] = {
+    { OSSL_FUNC_MAC_NEWCTX, reinterpret_cast<dispatchFunction>(&macNew) },
+    { OSSL_FUNC_MAC_DUPCTX, reinterpret_cast<dispatchFunction>(&macDup) },
+    { OSSL_FUNC_MAC_FREECTX, reinterpret_cast<dispatchFunction>(&macFree) },
+    { OSSL_FUNC_MAC_INIT, reinterpret_cast<dispatchFunction>(&macInit) },
+    { OSSL_FUNC_MAC_UPDATE, reinterpret_cast<dispatchFunction>(&macUpdate) },
+    { OSSL_FUNC_MAC_FINAL, reinterpret_cast<dispatchFunction>(&macFinal) },
+    { OSSL_FUNC_MAC_GET_CTX_PARAMS, reinterpret_cast<dispatchFunction>(&macGetCtxParams) },
+    { OSSL_FUNC_MAC_SET_CTX_PARAMS, reinterpret_cast<dispatchFunction>(&macSetCtxParams) },
+    { OSSL_FUNC_MAC_GETTABLE_CTX_PARAMS, reinterpret_cast<dispatchFunction>(&macGettableCtxParams) },
+    { OSSL_FUNC_MAC_SETTABLE_CTX_PARAMS, reinterpret_cast<dispatchFunction>(&macSettableCtxParams) },
+    { 0, nullptr }
+};
+
+
+/*
+* 
+*/
+
+const OSSL_ALGORITHM ciphers[] = {
+    { "KUZNYECHIK-ECB:GRASSHOPPER-ECB", "provider=kuznyechik", cipherDispatch<modeEcb>::table, nullptr },
+    { "KUZNYECHIK-CBC:GRASSHOPPER-CBC", "provider=kuznyechik", cipherDispatch<modeCbc>::table, nullptr },
+    { "KUZNYECHIK-CTR:GRASSHOPPER-CTR", "provider=kuznyechik", cipherDispatch<modeCtr>::table, nullptr },
+    { "KUZNYECHIK-MGM:GRASSHOPPER-MGM", "provider=kuznyechik", cipherDispatch<modeMgm>::table, nullptr },
+    { nullptr, nullptr, nullptr, nullptr }
+};
+
+const OSSL_ALGORITHM macs[] = {
+    { "KUZNYECHIK-MAC:KUZNYECHIK-CMAC:GRASSHOPPER-MAC", "provider=kuznyechik", macDispatch, nullptr },
+    { nullptr, nullptr, nullptr, nullptr }
+};
+
+
+const OSSL_ALGORITHM* providerQuery(void*, int operation, int* noCache) {
+    *noCache = 0;
+    switch (operation) {
+    case OSSL_OP_CIPHER:
+        return ciphers;
+    case OSSL_OP_MAC:
+        return macs;
+    }
+    return nullptr;
+}
+
+
+const OSSL_PARAM* providerGettableParams(void*) {
+    static const OSSL_PARAM table[] = {
+        OSSL_PARAM_utf8_ptr(OSSL_PROV_PARAM_NAME, nullptr, 0),
+        OSSL_PARAM_utf8_ptr(OSSL_PROV_PARAM_VERSION, nullptr, 0),
+        OSSL_PARAM_int(OSSL_PROV_PARAM_STATUS, nullptr),
+        OSSL_PARAM_END
+    };
+    return table;
+}
+
+
+int providerGetParams(void*, OSSL_PARAM params[]) {
+    OSSL_PARAM* p;
+
+    if ((p = OSSL_PARAM_locate(params, OSSL_PROV_PARAM_NAME))
+        && !OSSL_PARAM_set_utf8_ptr(p, "GOST R 34.12-2015 Kuznyechik provider")) {
+        return 0;
+    }
+    if ((p = OSSL_PARAM_locate(params, OSSL_PROV_PARAM_VERSION)) && !OSSL_PARAM_set_utf8_ptr(p, "1.0")) {
+        return 0;
+    }
+    if ((p = OSSL_PARAM_locate(params, OSSL_PROV_PARAM_STATUS)) && !OSSL_PARAM_set_int(p, 1)) {
+        return 0;
+    }
+    return 1;
+}
+
+
+void providerTeardown(void*) {
+}
+
+
+const OSSL_DISPATCH providerDispatch[] = {
+    { OSSL_FUNC_PROVIDER_TEARDOWN, reinterpret_cast<dispatchFunction>(&providerTeardown) },
+    { OSSL_FUNC_PROVIDER_GETTABLE_PARAMS, reinterpret_cast<dispatchFunction>(&providerGettableParams) },
+    { OSSL_FUNC_PROVIDER_GET_PARAMS, reinterpret_cast<dispatchFunction>(&providerGetParams) },
+    { OSSL_FUNC_PROVIDER_QUERY_OPERATION, reinterpret_cast<dispatchFunction>(&providerQuery) },
+    { 0, nullptr }
+};
+
+}
+
+
+/**
+* \brief   ,  OpenSSL   .
+*/
+extern "C"
+#ifdef _WIN32
+__declspec(dllexport)
+#else
+__attribute__((visibility("default")))
+#endif
+int OSSL_provider_init(const OSSL_CORE_HANDLE* handle, const OSSL_DISPATCH*, const OSSL_DISPATCH** out,
+                       void** providerContext) {
+    initCipher();
+    *out = providerDispatch;
+    *providerContext = const_cast<OSSL_CORE_HANDLE*>(handle);
+    return 1;
+}